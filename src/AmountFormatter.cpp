@@ -0,0 +1,132 @@
+// Copyright (c) 2016-2017 The Chavezcoin developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <limits>
+
+#include <QVarLengthArray>
+
+#include "AmountFormatter.h"
+
+namespace WalletGui {
+
+namespace {
+
+const QLatin1Char DECIMAL_POINT('.');
+const QLatin1Char GROUP_SEPARATOR(',');
+
+// 20 integer digits, 6 separators and the point
+const int MAX_INTEGER_PART_SIZE = 27;
+
+}
+
+QString AmountFormatter::format(quint64 _amount, quintptr _decimalPlaces) {
+  QVarLengthArray<QChar, MAX_INTEGER_PART_SIZE + 20> buffer(MAX_INTEGER_PART_SIZE + _decimalPlaces);
+  QChar* end = buffer.data() + buffer.size();
+  QChar* pos = end;
+  bool trimZeros = true;
+  for (quintptr i = 0; i < _decimalPlaces; ++i) {
+    char digit = '0' + _amount % 10;
+    _amount /= 10;
+    if (trimZeros && digit == '0' && _decimalPlaces - i > 2) {
+      continue;
+    }
+
+    trimZeros = false;
+    *--pos = QLatin1Char(digit);
+  }
+
+  *--pos = DECIMAL_POINT;
+  quint32 groupSize = 0;
+  do {
+    if (groupSize == 3) {
+      *--pos = GROUP_SEPARATOR;
+      groupSize = 0;
+    }
+
+    *--pos = QLatin1Char('0' + _amount % 10);
+    _amount /= 10;
+    ++groupSize;
+  } while (_amount > 0);
+
+  return QString(pos, end - pos);
+}
+
+quint64 AmountFormatter::parse(const QString& _amountString, quintptr _decimalPlaces) {
+  const QChar* begin = _amountString.constData();
+  const QChar* end = begin + _amountString.size();
+  while (begin < end && begin->isSpace()) {
+    ++begin;
+  }
+
+  while (end > begin && (end - 1)->isSpace()) {
+    --end;
+  }
+
+  quint64 result = 0;
+  quintptr fractionSize = 0;
+  bool hasSign = false;
+  bool hasPoint = false;
+  bool hasDigits = false;
+  for (const QChar* pos = begin; pos < end; ++pos) {
+    if (*pos == GROUP_SEPARATOR) {
+      continue;
+    }
+
+    if (*pos == QLatin1Char('+') && !hasSign && !hasPoint && !hasDigits) {
+      hasSign = true;
+      continue;
+    }
+
+    if (*pos == DECIMAL_POINT) {
+      if (hasPoint) {
+        return 0;
+      }
+
+      hasPoint = true;
+      continue;
+    }
+
+    ushort ch = pos->unicode();
+    if (ch < '0' || ch > '9') {
+      return 0;
+    }
+
+    quint32 digit = ch - '0';
+    hasDigits = true;
+    if (hasPoint) {
+      // Extra fraction digits are only fine as long as they are zeros
+      if (fractionSize == _decimalPlaces) {
+        if (digit != 0) {
+          return 0;
+        }
+
+        continue;
+      }
+
+      ++fractionSize;
+    }
+
+    if (result > (std::numeric_limits<quint64>::max() - digit) / 10) {
+      return 0;
+    }
+
+    result = result * 10 + digit;
+  }
+
+  if (!hasDigits) {
+    return 0;
+  }
+
+  for (; fractionSize < _decimalPlaces; ++fractionSize) {
+    if (result > std::numeric_limits<quint64>::max() / 10) {
+      return 0;
+    }
+
+    result *= 10;
+  }
+
+  return result;
+}
+
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2016-2017 The Chavezcoin developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <QString>
+
+namespace WalletGui {
+
+// Conversion between atomic units and the "1,234.56" text shown in the wallet. Kept apart from
+// CurrencyAdapter so it depends on QtCore only.
+class AmountFormatter {
+
+public:
+  // Integer part grouped by three, fraction with trailing zeros cut down to two digits
+  static QString format(quint64 _amount, quintptr _decimal_places);
+  // Returns 0 for malformed or out of range text, as well as for zero
+  static quint64 parse(const QString& _amount_string, quintptr _decimal_places);
+};
+
+}
@@ -25,10 +25,18 @@
 #include "Settings.h"
 #include <QDebug>
 
+#include <chrono>
+#include <memory>
+
 namespace WalletGui {
 
 namespace {
 
+const std::chrono::seconds GETINFO_CACHE_TIME(2);
+// The wallet never asks the embedded node for explorer-style lookups (payment id, timestamp,
+// generated transactions), so the core doesn't keep those indices in memory
+const bool BLOCKCHAIN_INDEXES_ENABLED = false;
+
 bool parsePaymentId(const std::string& payment_id_str, Crypto::Hash& payment_id) {
   return CryptoNote::parsePaymentId(payment_id_str, payment_id);
 }
@@ -134,10 +142,7 @@ public:
     req.threads_count = threads_count;
 
     try {
-        //CryptoNote::HttpClient httpClient(m_dispatcher, "127.0.0.1", Settings::instance().getCurrentLocalDaemonPort());
-        CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-
-        CryptoNote::invokeJsonCommand(httpClient, "/start_mining", req, res);
+        invokeDaemonCommand("/start_mining", req, res);
 
         std::string err = interpret_rpc_response(true, res.status);
         if (err.empty())
@@ -157,10 +162,7 @@ public:
       CryptoNote::COMMAND_RPC_STOP_MINING::response res;
 
       try {
-         //CryptoNote::HttpClient httpClient(m_dispatcher, "127.0.0.1", Settings::instance().getCurrentLocalDaemonPort());
-         CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-
-          CryptoNote::invokeJsonCommand(httpClient, "/stop_mining", req, res);
+          invokeDaemonCommand("/stop_mining", req, res);
           std::string err = interpret_rpc_response(true, res.status);
           if (err.empty())
             qDebug() << "Mining stopped in daemon";
@@ -198,201 +200,48 @@ public:
   }
 
   uint64_t getDifficulty() {
-    try {
-        CryptoNote::COMMAND_RPC_GET_INFO::request req;
-        CryptoNote::COMMAND_RPC_GET_INFO::response res;
-        CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-        CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-        std::string err = interpret_rpc_response(true, res.status);
-      if (err.empty())
-        return res.difficulty;
-      else {
-        qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-        return 0;
-      }}
-        catch (const CryptoNote::ConnectException&) {
-        qDebug() << "Wallet failed to connect to daemon.";
-        return 0;
-      } catch (const std::exception& e) {
-        qDebug() << "Failed to invoke rpc method: " << e.what();
-        return 0;
-      }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->difficulty;
   }
 
   uint64_t getTxCount() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.tx_count;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->tx_count;
   }
 
   uint64_t getTxPoolSize() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.tx_pool_size;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->tx_pool_size;
   }
 
   uint64_t getAltBlocksCount() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.alt_blocks_count;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->alt_blocks_count;
   }
 
   uint64_t getConnectionsCount() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.outgoing_connections_count + res.incoming_connections_count;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->outgoing_connections_count + info->incoming_connections_count;
   }
 
   uint64_t getOutgoingConnectionsCount() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.outgoing_connections_count;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->outgoing_connections_count;
   }
 
   uint64_t getIncomingConnectionsCount() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.incoming_connections_count;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->incoming_connections_count;
   }
 
   uint64_t getWhitePeerlistSize() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.white_peerlist_size;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->white_peerlist_size;
   }
 
   uint64_t getGreyPeerlistSize() {
-      try {
-          CryptoNote::COMMAND_RPC_GET_INFO::request req;
-          CryptoNote::COMMAND_RPC_GET_INFO::response res;
-          CryptoNote::HttpClient httpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort);
-          CryptoNote::invokeJsonCommand(httpClient, "/getinfo", req, res);
-          std::string err = interpret_rpc_response(true, res.status);
-        if (err.empty())
-          return res.grey_peerlist_size;
-        else {
-          qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
-          return 0;
-        }}
-          catch (const CryptoNote::ConnectException&) {
-          qDebug() << "Wallet failed to connect to daemon.";
-          return 0;
-        } catch (const std::exception& e) {
-          qDebug() << "Failed to invoke rpc method: " << e.what();
-          return 0;
-        }
+    const CryptoNote::COMMAND_RPC_GET_INFO::response* info = getInfo();
+    return info == nullptr ? 0 : info->grey_peerlist_size;
   }
 
   CryptoNote::IWalletLegacy* createWallet() override {
@@ -404,6 +253,71 @@ private:
   const CryptoNote::Currency& m_currency;
   CryptoNote::NodeRpcProxy m_node;
   System::Dispatcher m_dispatcher;
+  std::unique_ptr<CryptoNote::HttpClient> m_httpClient;
+  CryptoNote::COMMAND_RPC_GET_INFO::response m_info;
+  std::chrono::steady_clock::time_point m_infoTime;
+  bool m_hasInfo = false;
+
+  // One keep-alive connection for all direct daemon calls
+  CryptoNote::HttpClient& getHttpClient() {
+    if (!m_httpClient) {
+      m_httpClient.reset(new CryptoNote::HttpClient(m_dispatcher, m_node.m_nodeHost, m_node.m_nodePort));
+    }
+
+    return *m_httpClient;
+  }
+
+  // The daemon or a proxy in front of it may have closed the idle connection, so a request that fails on
+  // a reused connection is retried once on a fresh one. A failed connection is never kept.
+  template <typename Request, typename Response>
+  void invokeDaemonCommand(const std::string& _url, const Request& _req, Response& _res) {
+    bool isReused = static_cast<bool>(m_httpClient);
+    try {
+      CryptoNote::invokeJsonCommand(getHttpClient(), _url, _req, _res);
+      return;
+    } catch (const std::exception&) {
+      m_httpClient.reset();
+      if (!isReused) {
+        throw;
+      }
+    }
+
+    try {
+      CryptoNote::invokeJsonCommand(getHttpClient(), _url, _req, _res);
+    } catch (const std::exception&) {
+      m_httpClient.reset();
+      throw;
+    }
+  }
+
+  // All the getters above are served from one /getinfo response; the info dialog and
+  // the mining page call several of them in a row, which used to cost a round trip each.
+  const CryptoNote::COMMAND_RPC_GET_INFO::response* getInfo() {
+    if (m_hasInfo && std::chrono::steady_clock::now() - m_infoTime < GETINFO_CACHE_TIME) {
+      return &m_info;
+    }
+
+    m_hasInfo = false;
+    try {
+      CryptoNote::COMMAND_RPC_GET_INFO::request req;
+      invokeDaemonCommand("/getinfo", req, m_info);
+      std::string err = interpret_rpc_response(true, m_info.status);
+      if (!err.empty()) {
+        qDebug() << "Failed to invoke request: " << QString::fromStdString(err);
+        return nullptr;
+      }
+    } catch (const CryptoNote::ConnectException&) {
+      qDebug() << "Wallet failed to connect to daemon.";
+      return nullptr;
+    } catch (const std::exception& e) {
+      qDebug() << "Failed to invoke rpc method: " << e.what();
+      return nullptr;
+    }
+
+    m_hasInfo = true;
+    m_infoTime = std::chrono::steady_clock::now();
+    return &m_info;
+  }
 
   void peerCountUpdated(size_t count) {
     m_callback.peerCountUpdated(*this, count);
@@ -427,7 +341,7 @@ public:
     m_coreConfig(coreConfig),
     m_netNodeConfig(netNodeConfig),
     m_protocolHandler(currency, m_dispatcher, m_core, nullptr, logManager),
-    m_core(currency, &m_protocolHandler, logManager, true),
+    m_core(currency, &m_protocolHandler, logManager, BLOCKCHAIN_INDEXES_ENABLED),
     m_nodeServer(m_dispatcher, m_protocolHandler, logManager),
     m_node(m_core, m_protocolHandler) {
 
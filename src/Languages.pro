@@ -14,6 +14,7 @@ DEPENDPATH = $$INCLUDEPATH
  
 
 SOURCES = main.cpp \
+AmountFormatter.cpp \
 CommandLineParser.cpp \
 CryptoNoteWrapper.cpp \
 CurrencyAdapter.cpp \
@@ -49,7 +50,7 @@ gui/RecentTransactionsModel.cpp \
 gui/SendFrame.cpp \
 gui/SortedTransactionsModel.cpp \
 gui/TransactionDetailsDialog.cpp \
-gui/TransactionFrame.cpp \
+gui/TransactionsExporter.cpp \
 gui/TransactionsFrame.cpp \
 gui/TransactionsListModel.cpp \
 gui/TransactionsModel.cpp \
@@ -66,7 +67,8 @@ gui/ImportTrackingKeyDialog.cpp \
 gui/InfoDialog.cpp \
  
 
-HEADERS = CommandLineParser.h \
+HEADERS = AmountFormatter.h \
+CommandLineParser.h \
 CryptoNoteWrapper.h \
 CurrencyAdapter.h \
 LoggerAdapter.h \
@@ -101,7 +103,7 @@ gui/RecentTransactionsModel.h \
 gui/SendFrame.h \
 gui/SortedTransactionsModel.h \
 gui/TransactionDetailsDialog.h \
-gui/TransactionFrame.h \
+gui/TransactionsExporter.h \
 gui/TransactionsFrame.h \
 gui/TransactionsListModel.h \
 gui/TransactionsModel.h \
@@ -136,7 +138,6 @@ gui/ui/receiveframe.ui \
 gui/ui/accountframe.ui \
 gui/ui/sendframe.ui \
 gui/ui/transactiondetailsdialog.ui \
-gui/ui/transactionframe.ui \
 gui/ui/transactionsframe.ui \
 gui/ui/transferframe.ui \
 gui/ui/changelanguagedialog.ui \
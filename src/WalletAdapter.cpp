@@ -27,31 +27,51 @@ const quint32 MSECS_IN_MINUTE = 60 * 1000;
 const quint32 LAST_BLOCK_INFO_UPDATING_INTERVAL = 1 * MSECS_IN_MINUTE;
 const quint32 LAST_BLOCK_INFO_WARNING_INTERVAL = 1 * MSECS_IN_HOUR;
 
+// While synchronizing, the wallet cache is saved every SYNC_CHECKPOINT_BLOCKS blocks
+// or SYNC_CHECKPOINT_INTERVAL, whichever comes first, so a crash doesn't lose the progress.
+const quint32 SYNC_CHECKPOINT_BLOCKS = 10000;
+const quint32 SYNC_CHECKPOINT_INTERVAL = 5 * MSECS_IN_MINUTE;
+
+// Synchronization progress is reported for every block, the status bar doesn't need more than a few updates per second
+const quint32 SYNC_STATUS_UPDATE_INTERVAL = 250;
+
 WalletAdapter& WalletAdapter::instance() {
   static WalletAdapter inst;
   return inst;
 }
 
 WalletAdapter::WalletAdapter() : QObject(), m_wallet(nullptr), m_mutex(), m_isBackupInProgress(false),
-  m_isSynchronized(false), m_newTransactionsNotificationTimer(),
-  m_lastWalletTransactionId(std::numeric_limits<quint64>::max()) {
+  m_isCheckpointInProgress(false), m_isSynchronized(false), m_newTransactionsNotificationTimer(),
+  m_syncCheckpointTimer(), m_lastWalletTransactionId(std::numeric_limits<quint64>::max()), m_syncCheckpointHeight(0),
+  m_syncProgressTime(0), m_syncStatusTimer(), m_syncRateHeight(0), m_syncRate(0) {
   connect(this, &WalletAdapter::walletInitCompletedSignal, this, &WalletAdapter::onWalletInitCompleted, Qt::QueuedConnection);
   connect(this, &WalletAdapter::walletSendTransactionCompletedSignal, this, &WalletAdapter::onWalletSendTransactionCompleted, Qt::QueuedConnection);
   connect(this, &WalletAdapter::updateBlockStatusTextSignal, this, &WalletAdapter::updateBlockStatusText, Qt::QueuedConnection);
   connect(this, &WalletAdapter::updateBlockStatusTextWithDelaySignal, this, &WalletAdapter::updateBlockStatusTextWithDelay, Qt::QueuedConnection);
+  connect(this, &WalletAdapter::syncCheckpointSignal, this, &WalletAdapter::saveSyncCheckpoint, Qt::QueuedConnection);
+  connect(this, &WalletAdapter::resetSyncStatusSignal, this, &WalletAdapter::resetSyncStatus, Qt::QueuedConnection);
+  connect(this, &WalletAdapter::walletSynchronizationProgressUpdatedSignal, this, &WalletAdapter::updateSyncStatus,
+    Qt::QueuedConnection);
   connect(&m_newTransactionsNotificationTimer, &QTimer::timeout, this, &WalletAdapter::notifyAboutLastTransaction);
+  connect(&m_syncCheckpointTimer, &QTimer::timeout, this, &WalletAdapter::saveSyncCheckpoint);
   connect(this, &WalletAdapter::walletSynchronizationProgressUpdatedSignal, this, [&]() {
     if (!m_newTransactionsNotificationTimer.isActive()) {
       m_newTransactionsNotificationTimer.start();
     }
+
+    if (!m_syncCheckpointTimer.isActive()) {
+      m_syncCheckpointTimer.start();
+    }
   }, Qt::QueuedConnection);
 
   connect(this, &WalletAdapter::walletSynchronizationCompletedSignal, this, [&]() {
     m_newTransactionsNotificationTimer.stop();
+    m_syncCheckpointTimer.stop();
     notifyAboutLastTransaction();
   }, Qt::QueuedConnection);
 
   m_newTransactionsNotificationTimer.setInterval(500);
+  m_syncCheckpointTimer.setInterval(SYNC_CHECKPOINT_INTERVAL);
 }
 
 WalletAdapter::~WalletAdapter() {
@@ -169,6 +189,9 @@ void WalletAdapter::close() {
   m_wallet->removeObserver(this);
   m_isSynchronized = false;
   m_newTransactionsNotificationTimer.stop();
+  m_syncCheckpointTimer.stop();
+  m_syncCheckpointHeight = 0;
+  resetSyncStatus();
   m_lastWalletTransactionId = std::numeric_limits<quint64>::max();
   Q_EMIT walletCloseCompletedSignal();
   QCoreApplication::processEvents();
@@ -248,6 +271,9 @@ void WalletAdapter::reset() {
   m_wallet->removeObserver(this);
   m_isSynchronized = false;
   m_newTransactionsNotificationTimer.stop();
+  m_syncCheckpointTimer.stop();
+  m_syncCheckpointHeight = 0;
+  resetSyncStatus();
   m_lastWalletTransactionId = std::numeric_limits<quint64>::max();
   Q_EMIT walletCloseCompletedSignal();
   QCoreApplication::processEvents();
@@ -296,6 +322,37 @@ bool WalletAdapter::getTransfer(CryptoNote::TransferId& _id, CryptoNote::WalletL
   return false;
 }
 
+// Holds the wallet lock for the whole pass, so it may run on another thread while the wallet stays open
+bool WalletAdapter::getTransactionsAndTransfers(QVector<CryptoNote::WalletLegacyTransaction>& _transactions,
+  QVector<CryptoNote::WalletLegacyTransfer>& _transfers) {
+  QMutexLocker locker(&m_mutex);
+  if (m_wallet == nullptr) {
+    return false;
+  }
+
+  try {
+    _transactions.resize(m_wallet->getTransactionCount());
+    for (CryptoNote::TransactionId id = 0; id < static_cast<CryptoNote::TransactionId>(_transactions.size()); ++id) {
+      if (!m_wallet->getTransaction(id, _transactions[id])) {
+        _transactions.resize(id);
+        break;
+      }
+    }
+
+    _transfers.resize(m_wallet->getTransferCount());
+    for (CryptoNote::TransferId id = 0; id < static_cast<CryptoNote::TransferId>(_transfers.size()); ++id) {
+      if (!m_wallet->getTransfer(id, _transfers[id])) {
+        _transfers.resize(id);
+        break;
+      }
+    }
+  } catch (std::system_error&) {
+    return false;
+  }
+
+  return true;
+}
+
 bool WalletAdapter::getAccountKeys(CryptoNote::AccountKeys& _keys) {
   Q_CHECK_PTR(m_wallet);
   try {
@@ -375,7 +432,14 @@ void WalletAdapter::onWalletInitCompleted(int _error, const QString& _errorText)
 }
 
 void WalletAdapter::saveCompleted(std::error_code _error) {
-  if (!_error && !m_isBackupInProgress) {
+  if (m_isCheckpointInProgress) {
+    // Checkpoints are silent, the status bar keeps showing the sync progress
+    m_isCheckpointInProgress = false;
+    closeFile();
+    if (!_error) {
+      renameFile(Settings::instance().getWalletFile() + ".temp", Settings::instance().getWalletFile());
+    }
+  } else if (!_error && !m_isBackupInProgress) {
     closeFile();
     renameFile(Settings::instance().getWalletFile() + ".temp", Settings::instance().getWalletFile());
     Q_EMIT walletStateChangedSignal(tr("Ready"));
@@ -392,18 +456,60 @@ void WalletAdapter::saveCompleted(std::error_code _error) {
 
 void WalletAdapter::synchronizationProgressUpdated(uint32_t _current, uint32_t _total) {
   m_isSynchronized = false;
-  Q_EMIT walletStateChangedSignal(QString("%1 %2/%3").arg(tr("Synchronizing")).arg(_current).arg(_total));
-  Q_EMIT walletSynchronizationProgressUpdatedSignal(_current, _total);
+  qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+  if (currentTime - m_syncProgressTime >= SYNC_STATUS_UPDATE_INTERVAL || _current == _total) {
+    m_syncProgressTime = currentTime;
+    Q_EMIT walletSynchronizationProgressUpdatedSignal(_current, _total);
+  }
+
+  quint32 checkpointHeight = m_syncCheckpointHeight;
+  if (checkpointHeight == 0) {
+    m_syncCheckpointHeight = _current;
+  } else if (_current >= checkpointHeight + SYNC_CHECKPOINT_BLOCKS) {
+    m_syncCheckpointHeight = _current;
+    Q_EMIT syncCheckpointSignal();
+  }
 }
 
 void WalletAdapter::synchronizationCompleted(std::error_code _error) {
+  // An interrupted sync restarts from another height, possibly much later
+  Q_EMIT resetSyncStatusSignal();
   if (!_error) {
     m_isSynchronized = true;
+    m_syncCheckpointHeight = 0;
     Q_EMIT updateBlockStatusTextSignal();
     Q_EMIT walletSynchronizationCompletedSignal(_error.value(), QString::fromStdString(_error.message()));
   }
 }
 
+// Runs on the GUI thread, like resetSyncStatus(), so the rate fields need no locking
+void WalletAdapter::updateSyncStatus(quint64 _current, quint64 _total) {
+  if (!m_syncStatusTimer.isValid()) {
+    m_syncStatusTimer.start();
+  } else {
+    qint64 elapsed = m_syncStatusTimer.restart();
+    if (elapsed > 0 && _current > m_syncRateHeight) {
+      double rate = (_current - m_syncRateHeight) * 1000.0 / elapsed;
+      m_syncRate = m_syncRate > 0 ? m_syncRate * 0.7 + rate * 0.3 : rate;
+    }
+  }
+
+  m_syncRateHeight = _current;
+  QString stateText = QString("%1 %2/%3").arg(tr("Synchronizing")).arg(_current).arg(_total);
+  if (m_syncRate > 0) {
+    stateText.append(QString("  |  %1").arg(tr("%1 blocks/s").arg(qRound(m_syncRate))));
+  }
+
+  Q_EMIT walletStateChangedSignal(stateText);
+}
+
+void WalletAdapter::resetSyncStatus() {
+  m_syncProgressTime = 0;
+  m_syncStatusTimer.invalidate();
+  m_syncRateHeight = 0;
+  m_syncRate = 0;
+}
+
 void WalletAdapter::actualBalanceUpdated(uint64_t _actual_balance) {
   Q_EMIT walletActualBalanceUpdatedSignal(_actual_balance);
 }
@@ -522,6 +628,33 @@ void WalletAdapter::notifyAboutLastTransaction() {
   }
 }
 
+void WalletAdapter::saveSyncCheckpoint() {
+  if (m_wallet == nullptr || m_isSynchronized || m_isBackupInProgress) {
+    return;
+  }
+
+  // Sending or saving holds the mutex until the wallet reports back; don't block the UI, wait for the next checkpoint
+  if (!m_mutex.tryLock()) {
+    return;
+  }
+
+  m_mutex.unlock();
+  if (!openFile(Settings::instance().getWalletFile() + ".temp", false)) {
+    return;
+  }
+
+  m_isCheckpointInProgress = true;
+  try {
+    m_wallet->save(m_file, true, true);
+  } catch (std::system_error&) {
+    m_isCheckpointInProgress = false;
+    closeFile();
+    return;
+  }
+
+  m_syncCheckpointTimer.start();
+}
+
 void WalletAdapter::renameFile(const QString& _oldName, const QString& _newName) {
   Q_ASSERT(QFile::exists(_oldName));
   QFile::remove(_newName);
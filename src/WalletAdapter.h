@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QObject>
 #include <QTimer>
@@ -38,6 +39,8 @@ public:
   quint64 getTransferCount() const;
   bool getTransaction(CryptoNote::TransactionId& _id, CryptoNote::WalletLegacyTransaction& _transaction);
   bool getTransfer(CryptoNote::TransferId& _id, CryptoNote::WalletLegacyTransfer& _transfer);
+  bool getTransactionsAndTransfers(QVector<CryptoNote::WalletLegacyTransaction>& _transactions,
+    QVector<CryptoNote::WalletLegacyTransfer>& _transfers);
   bool getAccountKeys(CryptoNote::AccountKeys& _keys);
   bool isOpen() const;
   void sendTransaction(const QVector<CryptoNote::WalletLegacyTransfer>& _transfers, quint64 _fee, const QString& _payment_id, quint64 _mixin);
@@ -59,9 +62,16 @@ private:
   CryptoNote::IWalletLegacy* m_wallet;
   QMutex m_mutex;
   std::atomic<bool> m_isBackupInProgress;
+  std::atomic<bool> m_isCheckpointInProgress;
   std::atomic<bool> m_isSynchronized;
   std::atomic<quint64> m_lastWalletTransactionId;
+  std::atomic<quint32> m_syncCheckpointHeight;
+  std::atomic<qint64> m_syncProgressTime;
   QTimer m_newTransactionsNotificationTimer;
+  QTimer m_syncCheckpointTimer;
+  QElapsedTimer m_syncStatusTimer;
+  quint64 m_syncRateHeight;
+  double m_syncRate;
 
   WalletAdapter();
   ~WalletAdapter();
@@ -76,6 +86,9 @@ private:
   bool openFile(const QString& _file, bool _read_only);
   void closeFile();
   void notifyAboutLastTransaction();
+  void saveSyncCheckpoint();
+  void updateSyncStatus(quint64 _current, quint64 _total);
+  void resetSyncStatus();
   void backupOnOpen();
   QString walletErrorMessage(int _error_code);
 
@@ -102,6 +115,8 @@ Q_SIGNALS:
   void reloadWalletTransactionsSignal();
   void updateBlockStatusTextSignal();
   void updateBlockStatusTextWithDelaySignal();
+  void syncCheckpointSignal();
+  void resetSyncStatusSignal();
 };
 
 
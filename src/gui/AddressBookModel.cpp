@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
@@ -34,7 +35,7 @@ QVariant AddressBookModel::data(const QModelIndex& _index, int _role) const {
     return QVariant();
   }
 
-  QJsonObject address = m_addressBook.at(_index.row()).toObject();
+  const AddressBookEntry& entry = m_addressBook[_index.row()];
 
   switch (_role) {
   case Qt::DisplayRole:
@@ -50,11 +51,11 @@ QVariant AddressBookModel::data(const QModelIndex& _index, int _role) const {
     }
 
   case ROLE_LABEL:
-    return address.value("label");
+    return entry.label;
   case ROLE_ADDRESS:
-    return address.value("address");
+    return entry.address;
   case ROLE_PAYMENTID:
-    return address.value("paymentid");
+    return entry.paymentId;
   default:
     return QVariant();
   }
@@ -100,40 +101,64 @@ int AddressBookModel::rowCount(const QModelIndex& _parent) const {
 }
 
 void AddressBookModel::addAddress(const QString& _label, const QString& _address, const QString& _paymentid) {
-  beginInsertRows(QModelIndex(), m_addressBook.size(), m_addressBook.size());
-  QJsonObject newAddress;
-  newAddress.insert("label", _label);
-  newAddress.insert("address", _address);
-  newAddress.insert("paymentid", _paymentid);
-  m_addressBook.append(newAddress);
+  int row = m_addressBook.size();
+  beginInsertRows(QModelIndex(), row, row);
+  AddressBookEntry entry = {_label, _address, _paymentid};
+  m_addressBook.append(entry);
+  if (!m_addressRows.contains(_address)) {
+    m_addressRows.insert(_address, row);
+  }
+
+  if (!m_labelRows.contains(_label)) {
+    m_labelRows.insert(_label, row);
+  }
+
   endInsertRows();
   saveAddressBook();
 }
 
 void AddressBookModel::removeAddress(quint32 _row) {
-  if (_row > m_addressBook.size() - 1) {
+  if (_row >= static_cast<quint32>(m_addressBook.size())) {
     return;
   }
 
   beginRemoveRows(QModelIndex(), _row, _row);
   m_addressBook.removeAt(_row);
+  rebuildIndex();
   endRemoveRows();
   saveAddressBook();
 }
 
 void AddressBookModel::reset() {
   beginResetModel();
-  while (!m_addressBook.empty()) {
-    m_addressBook.removeFirst();
-  }
-
+  m_addressBook.clear();
+  m_addressRows.clear();
+  m_labelRows.clear();
   endResetModel();
 }
 
+void AddressBookModel::rebuildIndex() {
+  m_addressRows.clear();
+  m_labelRows.clear();
+  for (int row = m_addressBook.size() - 1; row >= 0; --row) {
+    m_addressRows.insert(m_addressBook[row].address, row);
+    m_labelRows.insert(m_addressBook[row].label, row);
+  }
+}
+
 void AddressBookModel::saveAddressBook() {
   QFile addressBookFile(Settings::instance().getAddressBookFile());
   if (addressBookFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-    QByteArray file_content = QJsonDocument(m_addressBook).toJson(QJsonDocument::Compact);
+    QJsonArray addressBook;
+    for (const AddressBookEntry& entry : m_addressBook) {
+      QJsonObject address;
+      address.insert("label", entry.label);
+      address.insert("address", entry.address);
+      address.insert("paymentid", entry.paymentId);
+      addressBook.append(address);
+    }
+
+    QByteArray file_content = QJsonDocument(addressBook).toJson(QJsonDocument::Compact);
     addressBookFile.write(file_content);
     addressBookFile.close();
   }
@@ -146,7 +171,17 @@ void AddressBookModel::walletInitCompleted(int _error, const QString& _error_tex
       QByteArray file_content = addressBookFile.readAll();
       QJsonDocument doc = QJsonDocument::fromJson(file_content);
       if (!doc.isNull()) {
-        m_addressBook = doc.array();
+        QJsonArray addressBook = doc.array();
+        m_addressBook.clear();
+        m_addressBook.reserve(addressBook.size());
+        for (const QJsonValue& value : addressBook) {
+          QJsonObject address = value.toObject();
+          AddressBookEntry entry = {address.value("label").toString(), address.value("address").toString(),
+            address.value("paymentid").toString()};
+          m_addressBook.append(entry);
+        }
+
+        rebuildIndex();
       }
 
       addressBookFile.close();
@@ -159,6 +194,18 @@ void AddressBookModel::walletInitCompleted(int _error, const QString& _error_tex
 }
 
 const QModelIndex AddressBookModel::indexFromContact(const QString& searchstring, const int& column){
+    QHash<QString, int>::const_iterator it;
+    switch (column) {
+    case COLUMN_LABEL:
+      it = m_labelRows.constFind(searchstring);
+      return (it != m_labelRows.constEnd() ? index(it.value(), column) : QModelIndex());
+    case COLUMN_ADDRESS:
+      it = m_addressRows.constFind(searchstring);
+      return (it != m_addressRows.constEnd() ? index(it.value(), column) : QModelIndex());
+    default:
+      break;
+    }
+
     QModelIndex index = match(AddressBookModel::index(0,column,QModelIndex()),
             Qt::DisplayRole, searchstring, 1,
             Qt::MatchFlags(Qt::MatchExactly|Qt::MatchRecursive))
@@ -167,4 +214,9 @@ const QModelIndex AddressBookModel::indexFromContact(const QString& searchstring
     return index;
 }
 
+QString AddressBookModel::getLabel(const QString& _address) const {
+  QHash<QString, int>::const_iterator it = m_addressRows.constFind(_address);
+  return (it != m_addressRows.constEnd() ? m_addressBook[it.value()].label : QString());
+}
+
 }
@@ -5,10 +5,17 @@
 #pragma once
 
 #include <QAbstractItemModel>
-#include <QJsonArray>
+#include <QHash>
+#include <QVector>
 
 namespace WalletGui {
-  
+
+struct AddressBookEntry {
+  QString label;
+  QString address;
+  QString paymentId;
+};
+
 class AddressBookModel : public QAbstractItemModel
 {
   Q_OBJECT
@@ -31,14 +38,19 @@ public:
   void removeAddress(quint32 _row);
 
   const QModelIndex indexFromContact(const QString& searchstring, const int& column);
+  QString getLabel(const QString& _address) const;
 
 private:
-  QJsonArray m_addressBook;
+  QVector<AddressBookEntry> m_addressBook;
+  // First row for each address and label, as found by a top-down search
+  QHash<QString, int> m_addressRows;
+  QHash<QString, int> m_labelRows;
 
   AddressBookModel();
   ~AddressBookModel();
 
   void reset();
+  void rebuildIndex();
   void saveAddressBook();
   void walletInitCompleted(int _error, const QString& _error_text);
 };
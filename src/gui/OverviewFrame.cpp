@@ -3,37 +3,77 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <QFontDatabase>
+#include <QPainter>
+
 #include "CurrencyAdapter.h"
+#include "MainWindow.h"
 #include "OverviewFrame.h"
-#include "TransactionFrame.h"
 #include "RecentTransactionsModel.h"
+#include "TransactionsModel.h"
 #include "WalletAdapter.h"
 
 #include "ui_overviewframe.h"
 
 namespace WalletGui {
 
+namespace {
+
+const int RECENT_TRANSACTION_MAX_WIDTH = 600;
+const int RECENT_TRANSACTION_MARGIN = 10;
+const int RECENT_TRANSACTION_SPACING = 20;
+
+}
+
+// Paints recent transactions directly, rows have no child widgets
 class RecentTransactionsDelegate : public QStyledItemDelegate {
   Q_OBJECT
 
 public:
-  RecentTransactionsDelegate(QObject* _parent) : QStyledItemDelegate(_parent) {
+  RecentTransactionsDelegate(QObject* _parent) : QStyledItemDelegate(_parent), m_hashFont(QFontDatabase::systemFont(QFontDatabase::FixedFont)) {
+    m_hashFont.setPixelSize(11);
   }
 
   ~RecentTransactionsDelegate() {
   }
 
-  QWidget* createEditor(QWidget* _parent, const QStyleOptionViewItem& _option, const QModelIndex& _index) const Q_DECL_OVERRIDE {
+  void paint(QPainter* _painter, const QStyleOptionViewItem& _option, const QModelIndex& _index) const Q_DECL_OVERRIDE {
     if (!_index.isValid()) {
-      return nullptr;
+      return;
     }
 
-    return new TransactionFrame(_index, _parent);
+    QModelIndex index = TransactionsModel::instance().index(_index.data(TransactionsModel::ROLE_ROW).toInt(), 0);
+    QRect rect = _option.rect;
+    rect.setWidth(qMin(rect.width(), RECENT_TRANSACTION_MAX_WIDTH));
+
+    _painter->save();
+    QPixmap icon = index.data(TransactionsModel::ROLE_ICON).value<QPixmap>();
+    QSize iconSize = icon.size() / icon.devicePixelRatio();
+    _painter->drawPixmap(rect.left(), rect.top() + (rect.height() - iconSize.height()) / 2, icon);
+
+    QRect textRect = rect.adjusted(iconSize.width() + RECENT_TRANSACTION_SPACING / 2, RECENT_TRANSACTION_MARGIN, 0, -RECENT_TRANSACTION_MARGIN);
+    _painter->setPen(_option.palette.color(QPalette::WindowText));
+    _painter->setFont(_option.font);
+    QRect topLineRect(textRect.topLeft(), QSize(textRect.width(), _option.fontMetrics.height()));
+    QString date = index.sibling(index.row(), TransactionsModel::COLUMN_DATE).data().toString();
+    _painter->drawText(topLineRect, Qt::AlignLeft | Qt::AlignVCenter, date);
+    QRect amountRect = topLineRect.adjusted(_option.fontMetrics.width(date) + RECENT_TRANSACTION_SPACING, 0, 0, 0);
+    _painter->drawText(amountRect, Qt::AlignRight | Qt::AlignVCenter,
+      index.sibling(index.row(), TransactionsModel::COLUMN_AMOUNT).data().toString());
+
+    _painter->setFont(m_hashFont);
+    QRect hashRect(textRect.left(), topLineRect.bottom() + 1, textRect.width(), textRect.bottom() - topLineRect.bottom());
+    QString hash = index.sibling(index.row(), TransactionsModel::COLUMN_HASH).data().toString();
+    _painter->drawText(hashRect, Qt::AlignLeft | Qt::AlignVCenter, QFontMetrics(m_hashFont).elidedText(hash, Qt::ElideRight, hashRect.width()));
+    _painter->restore();
   }
 
   QSize sizeHint(const QStyleOptionViewItem& _option, const QModelIndex& _index) const Q_DECL_OVERRIDE {
     return QSize(346, 64);
   }
+
+private:
+  QFont m_hashFont;
 };
 
 OverviewFrame::OverviewFrame(QWidget* _parent) : QFrame(_parent), m_ui(new Ui::OverviewFrame), m_transactionModel(new RecentTransactionsModel) {
@@ -44,8 +84,7 @@ OverviewFrame::OverviewFrame(QWidget* _parent) : QFrame(_parent), m_ui(new Ui::O
     Qt::QueuedConnection);
   connect(&WalletAdapter::instance(), &WalletAdapter::walletCloseCompletedSignal, this, &OverviewFrame::reset,
     Qt::QueuedConnection);
-  connect(m_transactionModel.data(), &QAbstractItemModel::rowsInserted, this, &OverviewFrame::transactionsInserted);
-  connect(m_transactionModel.data(), &QAbstractItemModel::layoutChanged, this, &OverviewFrame::layoutChanged);
+  connect(m_ui->m_recentTransactionsView, &QAbstractItemView::clicked, this, &OverviewFrame::recentTransactionClicked);
 
   m_ui->m_tickerLabel1->setText(CurrencyAdapter::instance().getCurrencyTicker().toUpper());
   m_ui->m_tickerLabel2->setText(CurrencyAdapter::instance().getCurrencyTicker().toUpper());
@@ -59,18 +98,8 @@ OverviewFrame::OverviewFrame(QWidget* _parent) : QFrame(_parent), m_ui(new Ui::O
 OverviewFrame::~OverviewFrame() {
 }
 
-void OverviewFrame::transactionsInserted(const QModelIndex& _parent, int _first, int _last) {
-  for (quint32 i = _first; i <= _last; ++i) {
-    QModelIndex recentModelIndex = m_transactionModel->index(i, 0);
-    m_ui->m_recentTransactionsView->openPersistentEditor(recentModelIndex);
-  }
-}
-
-void OverviewFrame::layoutChanged() {
-  for (quint32 i = 0; i <= m_transactionModel->rowCount(); ++i) {
-    QModelIndex recent_index = m_transactionModel->index(i, 0);
-    m_ui->m_recentTransactionsView->openPersistentEditor(recent_index);
-  }
+void OverviewFrame::recentTransactionClicked(const QModelIndex& _index) {
+  MainWindow::instance().scrollToTransaction(TransactionsModel::instance().index(_index.data(TransactionsModel::ROLE_ROW).toInt(), 0));
 }
 
 void OverviewFrame::updateActualBalance(quint64 _balance) {
@@ -27,9 +27,7 @@ private:
   QScopedPointer<Ui::OverviewFrame> m_ui;
   QSharedPointer<RecentTransactionsModel> m_transactionModel;
 
-  void transactionsInserted(const QModelIndex& _parent, int _first, int _last);
-  void transactionsRemoved(const QModelIndex& _parent, int _first, int _last);
-  void layoutChanged();
+  void recentTransactionClicked(const QModelIndex& _index);
   void updateActualBalance(quint64 _balance);
   void updatePendingBalance(quint64 _balance);
   void reset();
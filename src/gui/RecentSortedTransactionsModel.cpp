@@ -3,8 +3,6 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
-#include <QDateTime>
-
 #include "RecentSortedTransactionsModel.h"
 #include "TransactionsModel.h"
 
@@ -25,21 +23,7 @@ RecentSortedTransactionsModel::~RecentSortedTransactionsModel() {
 }
 
 bool RecentSortedTransactionsModel::lessThan(const QModelIndex& _left, const QModelIndex& _right) const {
-  QDateTime leftDate = _left.data(TransactionsModel::ROLE_DATE).toDateTime();
-  QDateTime rightDate = _right.data(TransactionsModel::ROLE_DATE).toDateTime();
-  if((rightDate.isNull() || !rightDate.isValid()) && (leftDate.isNull() || !leftDate.isValid())) {
-    return _left.row() < _right.row();
-  }
-
-  if(leftDate.isNull() || !leftDate.isValid()) {
-    return false;
-  }
-
-  if(rightDate.isNull() || !rightDate.isValid()) {
-    return true;
-  }
-
-  return leftDate < rightDate;
+  return TransactionsModel::instance().lessThanByDate(_left.row(), _right.row());
 }
 
 }
@@ -44,35 +44,11 @@ bool SortedTransactionsModel::filterAcceptsRow(int _row, const QModelIndex &_par
       return false;
   }
 
-  QModelIndex index2 = sourceModel()->index(_row, 2, _parent);
-  QModelIndex index3 = sourceModel()->index(_row, 3, _parent);
-  QModelIndex index4 = sourceModel()->index(_row, 4, _parent);
-  QModelIndex index5 = sourceModel()->index(_row, 5, _parent);
-
-  return (sourceModel()->data(index2).toString().contains(searchstring,Qt::CaseInsensitive)
-       || sourceModel()->data(index3).toString().contains(searchstring,Qt::CaseInsensitive)
-       || sourceModel()->data(index4).toString().contains(searchstring,Qt::CaseInsensitive)
-       || sourceModel()->data(index5).toString().contains(searchstring,Qt::CaseInsensitive));
-
-  return true;
- }
+  return TransactionsModel::instance().rowContainsText(_row, searchstring);
+}
 
 bool SortedTransactionsModel::lessThan(const QModelIndex& _left, const QModelIndex& _right) const {
-  QDateTime leftDate = _left.data(TransactionsModel::ROLE_DATE).toDateTime();
-  QDateTime rightDate = _right.data(TransactionsModel::ROLE_DATE).toDateTime();
-  if((rightDate.isNull() || !rightDate.isValid()) && (leftDate.isNull() || !leftDate.isValid())) {
-      return _left.row() < _right.row();
-  }
-
-  if(leftDate.isNull() || !leftDate.isValid()) {
-     return false;
-  }
-
-  if(rightDate.isNull() || !rightDate.isValid()) {
-     return true;
-  }
-
-  return leftDate < rightDate;
+  return TransactionsModel::instance().lessThanByDate(_left.row(), _right.row());
 }
 
 void SortedTransactionsModel::setDateRange(const QDateTime &from, const QDateTime &to)
@@ -83,7 +59,10 @@ void SortedTransactionsModel::setDateRange(const QDateTime &from, const QDateTim
 }
 
 void SortedTransactionsModel::setSearchFor(const QString &searchstring) {
-    this->searchstring = searchstring;
+    QString text = searchstring.toLower();
+    if (text == this->searchstring)
+      return;
+    this->searchstring = text;
     invalidateFilter();
 }
 
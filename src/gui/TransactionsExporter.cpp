@@ -0,0 +1,170 @@
+// Copyright (c) 2016-2017 The Chavezcoin developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include "CurrencyAdapter.h"
+#include "NodeAdapter.h"
+#include "TransactionsExporter.h"
+#include "TransactionsModel.h"
+#include "WalletAdapter.h"
+
+namespace WalletGui {
+
+namespace {
+
+const int WRITE_BUFFER_SIZE = 64 * 1024;
+const int PROGRESS_STEP = 1000;
+
+QByteArray csvField(const QString& _value) {
+  return '"' + _value.toUtf8().replace('"', "\"\"") + '"';
+}
+
+QString formatSignedAmount(qint64 _amount) {
+  QString amountStr = CurrencyAdapter::instance().formatAmount(qAbs(_amount)).remove(',');
+  return (_amount < 0 ? "-" + amountStr : amountStr);
+}
+
+}
+
+TransactionsExporter::TransactionsExporter(const QString& _fileName, Format _format, QObject* _parent) : QThread(_parent),
+  m_fileName(_fileName), m_format(_format), m_walletAddress(WalletAdapter::instance().getAddress()),
+  m_knownBlockHeight(NodeAdapter::instance().getLastKnownBlockHeight()), m_isCanceled(false) {
+}
+
+TransactionsExporter::~TransactionsExporter() {
+  cancel();
+  wait();
+}
+
+void TransactionsExporter::setTransfers(const QVector<TransactionTransferId>& _transfers) {
+  m_transfers = _transfers;
+}
+
+void TransactionsExporter::setContactLabels(const QHash<QString, QString>& _labels) {
+  m_contactLabels = _labels;
+}
+
+void TransactionsExporter::cancel() {
+  m_isCanceled = true;
+}
+
+void TransactionsExporter::run() {
+  QString error;
+  bool success = exportTransactions(error);
+  Q_EMIT exportCompletedSignal(success, error);
+}
+
+bool TransactionsExporter::exportTransactions(QString& _error) {
+  QVector<CryptoNote::WalletLegacyTransaction> transactions;
+  QVector<CryptoNote::WalletLegacyTransfer> transfers;
+  if (!WalletAdapter::instance().getTransactionsAndTransfers(transactions, transfers)) {
+    _error = tr("Wallet is not open");
+    return false;
+  }
+
+  // QSaveFile leaves an existing file untouched unless the export completes
+  QSaveFile file(m_fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    _error = file.errorString();
+    return false;
+  }
+
+  QByteArray buffer;
+  buffer.reserve(WRITE_BUFFER_SIZE + 1024);
+  if (m_format == FORMAT_CSV) {
+    buffer.append("\"Confirmations\",\"Date\",\"Amount\",\"Fee\",\"Hash\",\"Height\",\"Address\",\"Payment ID\",\"Type\"\n");
+  }
+
+  // Transfers of one transaction are adjacent in the view, so the payment id is extracted once for them
+  CryptoNote::TransactionId paymentIdTransactionId = CryptoNote::WALLET_LEGACY_INVALID_TRANSACTION_ID;
+  QString paymentId;
+  for (int i = 0; i < m_transfers.size(); ++i) {
+    if (i % PROGRESS_STEP == 0) {
+      if (m_isCanceled) {
+        file.cancelWriting();
+        return false;
+      }
+
+      Q_EMIT progressSignal(i, m_transfers.size());
+    }
+
+    CryptoNote::TransactionId transactionId = m_transfers[i].first;
+    CryptoNote::TransferId transferId = m_transfers[i].second;
+    if (transactionId >= static_cast<CryptoNote::TransactionId>(transactions.size())) {
+      continue;
+    }
+
+    const CryptoNote::WalletLegacyTransaction& transaction = transactions[transactionId];
+    if (transactionId != paymentIdTransactionId) {
+      paymentIdTransactionId = transactionId;
+      paymentId.clear();
+      try {
+        paymentId = NodeAdapter::instance().extractPaymentId(transaction.extra);
+      } catch (std::runtime_error&) {
+      }
+    }
+
+    QString transferAddress;
+    qint64 amount = transaction.totalAmount;
+    if (transferId != CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID && transferId < static_cast<CryptoNote::TransferId>(transfers.size())) {
+      transferAddress = QString::fromStdString(transfers[transferId].address);
+      amount = -transfers[transferId].amount;
+    }
+
+    quint8 type = TransactionsModel::getTransactionType(transaction, transferAddress, m_walletAddress);
+    QString address = TransactionsModel::formatAddress(type, transferAddress, m_walletAddress, m_contactLabels.value(transferAddress));
+    quint64 numberOfConfirmations = (transaction.blockHeight == CryptoNote::WALLET_LEGACY_UNCONFIRMED_TRANSACTION_HEIGHT ? 0 :
+      m_knownBlockHeight - transaction.blockHeight + 1);
+    QString dateStr = (transaction.timestamp > 0 ? QDateTime::fromTime_t(transaction.timestamp).toString("dd.MM.yy HH:mm") : "-");
+    QString hash = QByteArray(reinterpret_cast<const char*>(&transaction.hash), sizeof(transaction.hash)).toHex().toUpper();
+    QString typeName = TransactionsModel::getTransactionTypeName(type);
+    if (m_format == FORMAT_CSV) {
+      buffer.append(csvField(QString::number(numberOfConfirmations))).append(',');
+      buffer.append(csvField(dateStr)).append(',');
+      buffer.append(csvField(formatSignedAmount(amount))).append(',');
+      buffer.append(csvField(CurrencyAdapter::instance().formatAmount(transaction.fee))).append(',');
+      buffer.append(csvField(hash)).append(',');
+      buffer.append(csvField(QString::number(transaction.blockHeight))).append(',');
+      buffer.append(csvField(address)).append(',');
+      buffer.append(csvField(paymentId)).append(',');
+      buffer.append(csvField(typeName)).append('\n');
+    } else {
+      QJsonObject line;
+      line.insert("confirmations", static_cast<qint64>(numberOfConfirmations));
+      line.insert("timestamp", static_cast<qint64>(transaction.timestamp));
+      line.insert("amount", formatSignedAmount(amount));
+      line.insert("fee", CurrencyAdapter::instance().formatAmount(transaction.fee));
+      line.insert("hash", hash);
+      line.insert("height", static_cast<qint64>(transaction.blockHeight));
+      line.insert("address", address);
+      line.insert("paymentId", paymentId);
+      line.insert("type", typeName);
+      buffer.append(QJsonDocument(line).toJson(QJsonDocument::Compact)).append('\n');
+    }
+
+    if (buffer.size() >= WRITE_BUFFER_SIZE) {
+      if (file.write(buffer) != buffer.size()) {
+        _error = file.errorString();
+        file.cancelWriting();
+        return false;
+      }
+
+      buffer.resize(0);
+    }
+  }
+
+  if (file.write(buffer) != buffer.size() || !file.commit()) {
+    _error = file.errorString();
+    return false;
+  }
+
+  Q_EMIT progressSignal(m_transfers.size(), m_transfers.size());
+  return true;
+}
+
+}
@@ -0,0 +1,52 @@
+// Copyright (c) 2016-2017 The Chavezcoin developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#pragma once
+
+#include <QHash>
+#include <QThread>
+
+#include <atomic>
+
+#include "TransactionsModel.h"
+
+namespace WalletGui {
+
+// Writes the wallet history straight from the wallet to a file on its own thread. One line per transfer with
+// confirmations, date, amount, fee, hash, height, address (as shown in the list), payment id and type name.
+class TransactionsExporter : public QThread {
+  Q_OBJECT
+  Q_DISABLE_COPY(TransactionsExporter)
+
+public:
+  enum Format {FORMAT_CSV, FORMAT_JSON_LINES};
+
+  TransactionsExporter(const QString& _file_name, Format _format, QObject* _parent);
+  ~TransactionsExporter();
+
+  // Rows to write, in output order
+  void setTransfers(const QVector<TransactionTransferId>& _transfers);
+  void setContactLabels(const QHash<QString, QString>& _labels);
+  void cancel();
+
+protected:
+  void run() Q_DECL_OVERRIDE;
+
+private:
+  QString m_fileName;
+  Format m_format;
+  QVector<TransactionTransferId> m_transfers;
+  QHash<QString, QString> m_contactLabels;
+  QString m_walletAddress;
+  quint64 m_knownBlockHeight;
+  std::atomic<bool> m_isCanceled;
+
+  bool exportTransactions(QString& _error);
+
+Q_SIGNALS:
+  void progressSignal(int _value, int _maximum);
+  void exportCompletedSignal(bool _success, const QString& _error_text);
+};
+
+}
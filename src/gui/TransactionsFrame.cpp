@@ -11,9 +11,14 @@
 #include <QComboBox>
 #include <QDateTimeEdit>
 
+#include <QMessageBox>
+#include <QProgressDialog>
+
+#include "AddressBookModel.h"
 #include "CurrencyAdapter.h"
 #include "MainWindow.h"
 #include "SortedTransactionsModel.h"
+#include "TransactionsExporter.h"
 #include "TransactionsFrame.h"
 #include "TransactionDetailsDialog.h"
 #include "TransactionsListModel.h"
@@ -24,8 +29,14 @@
 
 namespace WalletGui {
 
+namespace {
+
+const int SEARCH_DELAY = 200;
+
+}
+
 TransactionsFrame::TransactionsFrame(QWidget* _parent) : QFrame(_parent), m_ui(new Ui::TransactionsFrame),
-  m_transactionsModel(new TransactionsListModel) {
+  m_transactionsModel(new TransactionsListModel), m_exporter(nullptr) {
   m_ui->setupUi(this);
   m_ui->m_transactionsView->setSortingEnabled(true);
   m_ui->m_transactionsView->sortByColumn(0, Qt::AscendingOrder);
@@ -75,6 +86,11 @@ TransactionsFrame::TransactionsFrame(QWidget* _parent) : QFrame(_parent), m_ui(n
   connect(m_ui->m_typeSelect, SIGNAL(activated(int)), this, SLOT(chooseType(int)));
   connect(m_ui->m_searchFor, SIGNAL(textChanged(QString)), this, SLOT(changedSearchFor(QString)));
 
+  // Filter once typing pauses instead of on every keystroke
+  m_searchTimer.setSingleShot(true);
+  m_searchTimer.setInterval(SEARCH_DELAY);
+  connect(&m_searchTimer, &QTimer::timeout, this, &TransactionsFrame::applySearchFor);
+
   // set sorting date range to include unconfirmed
   includeUnconfirmed();
   // set sorting to include all types of transactions
@@ -94,44 +110,71 @@ void TransactionsFrame::scrollToTransaction(const QModelIndex& _index) {
 }
 
 void TransactionsFrame::exportToCsv() {
-  QString file = QFileDialog::getSaveFileName(&MainWindow::instance(), tr("Select CSV file"), QDir::homePath(), "CSV (*.csv)");
-  if (!file.isEmpty()) {
-    QByteArray res;
-    res.append("\"State\",\"Date\",\"Amount\",\"Fee\",\"Hash\",\"Height\",\"Address\",\"Payment ID\"\n");
-    QModelIndexList selection = m_ui->m_transactionsView->selectionModel()->selectedRows();
-    if(selection.isEmpty()) {
-      m_ui->m_transactionsView->selectAll();
-      QModelIndexList all = m_ui->m_transactionsView->selectionModel()->selectedRows();
-      foreach (QModelIndex index, all){
-        res.append("\"").append(index.data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_DATE).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_AMOUNT).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(CurrencyAdapter::instance().formatAmount(index.data(TransactionsModel::ROLE_FEE).value<quint64>())).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_HASH).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.data(TransactionsModel::ROLE_HEIGHT).toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_ADDRESS).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_PAYMENT_ID).data().toString().toUtf8()).append("\"\n");
-      }
-      m_ui->m_transactionsView->clearSelection();
-    } else {
-      foreach (QModelIndex index, selection){
-        res.append("\"").append(index.data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_DATE).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_AMOUNT).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(CurrencyAdapter::instance().formatAmount(index.data(TransactionsModel::ROLE_FEE).value<quint64>())).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_HASH).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.data(TransactionsModel::ROLE_HEIGHT).toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_ADDRESS).data().toString().toUtf8()).append("\",");
-        res.append("\"").append(index.sibling(index.row(), TransactionsModel::COLUMN_PAYMENT_ID).data().toString().toUtf8()).append("\"\n");
-      }
-    }
+  if (m_exporter != nullptr) {
+    return;
+  }
+
+  QString selectedFilter;
+  QString file = QFileDialog::getSaveFileName(&MainWindow::instance(), tr("Select export file"), QDir::homePath(),
+    tr("CSV (*.csv);;JSON Lines (*.jsonl)"), &selectedFilter);
+  if (file.isEmpty()) {
+    return;
+  }
 
-    QFile f(file);
-    if (f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-      f.write(res);
-      f.close();
+  TransactionsExporter::Format format = (selectedFilter.contains("jsonl") || file.endsWith(".jsonl", Qt::CaseInsensitive)) ?
+    TransactionsExporter::FORMAT_JSON_LINES : TransactionsExporter::FORMAT_CSV;
+  m_exporter = new TransactionsExporter(file, format, this);
+
+  // Export exactly the rows shown: the selection, or else everything the filters let through, in view order
+  if (m_searchTimer.isActive()) {
+    m_searchTimer.stop();
+    applySearchFor();
+  }
+
+  QModelIndexList indexes = m_ui->m_transactionsView->selectionModel()->selectedRows();
+  if (indexes.isEmpty()) {
+    QAbstractItemModel* viewModel = m_ui->m_transactionsView->model();
+    for (int row = 0; row < viewModel->rowCount(); ++row) {
+      indexes.append(viewModel->index(row, 0));
     }
   }
+
+  QVector<TransactionTransferId> transfers;
+  transfers.reserve(indexes.size());
+  Q_FOREACH (const QModelIndex& index, indexes) {
+    transfers.append(TransactionsModel::instance().getTransactionTransferId(index.data(TransactionsModel::ROLE_ROW).toInt()));
+  }
+
+  m_exporter->setTransfers(transfers);
+
+  QHash<QString, QString> contactLabels;
+  for (int row = 0; row < AddressBookModel::instance().rowCount(); ++row) {
+    QModelIndex index = AddressBookModel::instance().index(row, 0);
+    contactLabels.insert(index.data(AddressBookModel::ROLE_ADDRESS).toString(), index.data(AddressBookModel::ROLE_LABEL).toString());
+  }
+
+  m_exporter->setContactLabels(contactLabels);
+
+  QProgressDialog* progressDialog = new QProgressDialog(tr("Exporting transactions..."), tr("Cancel"), 0, 0, &MainWindow::instance());
+  progressDialog->setWindowModality(Qt::WindowModal);
+  progressDialog->setMinimumDuration(500);
+  progressDialog->setAttribute(Qt::WA_DeleteOnClose);
+  connect(m_exporter, &TransactionsExporter::progressSignal, progressDialog, [progressDialog](int _value, int _maximum) {
+    progressDialog->setMaximum(_maximum);
+    progressDialog->setValue(_value);
+  });
+  connect(progressDialog, &QProgressDialog::canceled, m_exporter, &TransactionsExporter::cancel);
+  connect(m_exporter, &TransactionsExporter::exportCompletedSignal, this, [this, progressDialog](bool _success, const QString& _errorText) {
+    progressDialog->close();
+    if (!_success && !_errorText.isEmpty()) {
+      QMessageBox::critical(&MainWindow::instance(), tr("Export failed"), _errorText, QMessageBox::Ok);
+    }
+  });
+  connect(m_exporter, &QThread::finished, this, [this]() {
+    m_exporter->deleteLater();
+    m_exporter = nullptr;
+  });
+  m_exporter->start();
 }
 
 void TransactionsFrame::showTransactionDetails(const QModelIndex& _index) {
@@ -326,11 +369,18 @@ void TransactionsFrame::changedSearchFor(const QString &searchstring)
 {
   if(!m_transactionsModel)
      return;
-  SortedTransactionsModel::instance().setSearchFor(searchstring);
+  Q_UNUSED(searchstring);
+  m_searchTimer.start();
+}
+
+void TransactionsFrame::applySearchFor() {
+  SortedTransactionsModel::instance().setSearchFor(m_ui->m_searchFor->text());
 }
 
 void TransactionsFrame::resetFilterClicked() {
   m_ui->m_searchFor->clear();
+  m_searchTimer.stop();
+  applySearchFor();
   m_ui->m_dateSelect->setCurrentIndex(1);
   m_ui->m_typeSelect->setCurrentIndex(0);
   SortedTransactionsModel::instance().setTxType(4);
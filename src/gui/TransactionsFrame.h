@@ -8,6 +8,7 @@
 #include <QWidget>
 #include <QFrame>
 #include <QMenu>
+#include <QTimer>
 
 #include <QStyledItemDelegate>
 
@@ -21,6 +22,7 @@ QT_END_NAMESPACE
 
 namespace WalletGui {
 
+class TransactionsExporter;
 class TransactionsListModel;
 
 class TransactionsFrame : public QFrame {
@@ -74,10 +76,12 @@ public Q_SLOTS:
 private:
   QScopedPointer<Ui::TransactionsFrame> m_ui;
   QScopedPointer<TransactionsListModel> m_transactionsModel;
+  TransactionsExporter* m_exporter;
   QMenu* contextMenu;
   QFrame *dateRangeWidget;
   QDateTimeEdit *dateFrom;
   QDateTimeEdit *dateTo;
+  QTimer m_searchTimer;
   QWidget *createDateRangeWidget();
   QString formatAmount(int64_t _amount) const;
 
@@ -88,6 +92,7 @@ private:
 private slots:
   void dateRangeChanged();
   void resetFilterClicked();
+  void applySearchFor();
 
 };
 
@@ -3,10 +3,14 @@
 // Distributed under the MIT/X11 software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <iterator>
+
 #include <QDateTime>
 #include <QFont>
+#include <QGuiApplication>
 #include <QMetaEnum>
 #include <QPixmap>
+#include <QThread>
 #include <QDebug>
 
 #include "CurrencyAdapter.h"
@@ -21,31 +25,106 @@ enum class TransactionType : quint8 {MINED, INPUT, OUTPUT, INOUT};
 
 namespace {
 
-QPixmap getTransactionIcon(TransactionType _transactionType) {
-  switch (_transactionType) {
-  case TransactionType::MINED:
-    return QPixmap(":icons/tx-mined");
-  case TransactionType::INPUT:
-    return QPixmap(":icons/tx-input");
-  case TransactionType::OUTPUT:
-    return QPixmap(":icons/tx-output");
-  case TransactionType::INOUT:
-    return QPixmap(":icons/tx-inout");
-  default:
-    break;
+// State icons by confirmation bucket, the last one is final
+const char* const STATE_ICONS[] = {":icons/unconfirmed", ":icons/clock1", ":icons/clock2", ":icons/clock3", ":icons/clock4",
+  ":icons/clock5", ":icons/transaction"};
+const quint8 STATE_ICON_CONFIRMED = sizeof(STATE_ICONS) / sizeof(STATE_ICONS[0]) - 1;
+
+quint8 getStateIconIndex(quint64 _numberOfConfirmations) {
+  if (_numberOfConfirmations == 0) {
+    return 0;
   }
 
-  return QPixmap();
+  return qMin<quint64>((_numberOfConfirmations + 2) / 2, STATE_ICON_CONFIRMED);
 }
 
+// Type icons in TransactionType order
+const char* const TRANSACTION_ICONS[] = {":icons/tx-mined", ":icons/tx-input", ":icons/tx-output", ":icons/tx-inout"};
+const QSize ADDRESS_ICON_SIZE(20, 20);
+
+// Loaded once into the function-static vectors below. Scaled icons are rendered at the screen
+// device pixel ratio, so views never scale them while painting.
+QVector<QPixmap> loadIcons(const char* const* _begin, const char* const* _end, const QSize& _size = QSize()) {
+  QVector<QPixmap> res;
+  qreal ratio = qApp->devicePixelRatio();
+  for (const char* const* icon = _begin; icon != _end; ++icon) {
+    QPixmap pixmap(*icon);
+    if (_size.isValid() && !pixmap.isNull()) {
+      pixmap = pixmap.scaled(_size * ratio, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+      pixmap.setDevicePixelRatio(ratio);
+    }
+
+    res.append(pixmap);
+  }
+
+  return res;
+}
+
+const QPixmap& getStateIcon(quint8 _index) {
+  static const QVector<QPixmap> icons = loadIcons(std::begin(STATE_ICONS), std::end(STATE_ICONS));
+  return icons[_index];
+}
+
+const QPixmap& getTransactionIcon(TransactionType _transactionType) {
+  static const QVector<QPixmap> icons = loadIcons(std::begin(TRANSACTION_ICONS), std::end(TRANSACTION_ICONS));
+  return icons[static_cast<quint8>(_transactionType)];
+}
+
+const QPixmap& getAddressIcon(TransactionType _transactionType) {
+  static const QVector<QPixmap> icons = loadIcons(std::begin(TRANSACTION_ICONS), std::end(TRANSACTION_ICONS), ADDRESS_ICON_SIZE);
+  return icons[static_cast<quint8>(_transactionType)];
 }
 
+QString extractPaymentId(const CryptoNote::WalletLegacyTransaction& _transaction) {
+  try {
+    return NodeAdapter::instance().extractPaymentId(_transaction.extra);
+  } catch (std::runtime_error&) {
+  }
+
+  return QString();
+}
+
+}
+
+class TransactionsLoader : public QThread {
+public:
+  const QVector<CryptoNote::WalletLegacyTransaction>& transactions() const {
+    return m_transactions;
+  }
+
+  const QVector<CryptoNote::WalletLegacyTransfer>& transfers() const {
+    return m_transfers;
+  }
+
+  const QVector<QString>& paymentIds() const {
+    return m_paymentIds;
+  }
+
+protected:
+  void run() Q_DECL_OVERRIDE {
+    if (!WalletAdapter::instance().getTransactionsAndTransfers(m_transactions, m_transfers)) {
+      m_transactions.clear();
+      m_transfers.clear();
+    }
+
+    m_paymentIds.reserve(m_transactions.size());
+    for (const CryptoNote::WalletLegacyTransaction& transaction : m_transactions) {
+      m_paymentIds.append(extractPaymentId(transaction));
+    }
+  }
+
+private:
+  QVector<CryptoNote::WalletLegacyTransaction> m_transactions;
+  QVector<CryptoNote::WalletLegacyTransfer> m_transfers;
+  QVector<QString> m_paymentIds;
+};
+
 TransactionsModel& TransactionsModel::instance() {
   static TransactionsModel inst;
   return inst;
 }
 
-TransactionsModel::TransactionsModel() : QAbstractItemModel() {
+TransactionsModel::TransactionsModel() : QAbstractItemModel(), m_loader(nullptr), m_knownBlockHeight(0) {
   connect(&WalletAdapter::instance(), &WalletAdapter::reloadWalletTransactionsSignal, this, &TransactionsModel::reloadWalletTransactions,
     Qt::QueuedConnection);
   connect(&WalletAdapter::instance(), &WalletAdapter::walletTransactionCreatedSignal, this,
@@ -56,6 +135,10 @@ TransactionsModel::TransactionsModel() : QAbstractItemModel() {
     Qt::QueuedConnection);
   connect(&WalletAdapter::instance(), &WalletAdapter::walletCloseCompletedSignal, this, &TransactionsModel::reset,
     Qt::QueuedConnection);
+  connect(&AddressBookModel::instance(), &QAbstractItemModel::rowsInserted, this, &TransactionsModel::addressBookChanged);
+  connect(&AddressBookModel::instance(), &QAbstractItemModel::rowsRemoved, this, &TransactionsModel::addressBookChanged);
+  connect(&AddressBookModel::instance(), &QAbstractItemModel::dataChanged, this, &TransactionsModel::addressBookChanged);
+  connect(&AddressBookModel::instance(), &QAbstractItemModel::modelReset, this, &TransactionsModel::addressBookChanged);
 }
 
 TransactionsModel::~TransactionsModel() {
@@ -135,18 +218,7 @@ QVariant TransactionsModel::headerData(int _section, Qt::Orientation _orientatio
 }
 
 QVariant TransactionsModel::data(const QModelIndex& _index, int _role) const {
-  if(!_index.isValid()) {
-    return QVariant();
-  }
-
-  CryptoNote::WalletLegacyTransaction transaction;
-  CryptoNote::WalletLegacyTransfer transfer;
-  CryptoNote::TransactionId transactionId = m_transfers.value(_index.row()).first;
-  CryptoNote::TransferId transferId = m_transfers.value(_index.row()).second;
-
-  if(!WalletAdapter::instance().getTransaction(transactionId, transaction) ||
-    (m_transfers.value(_index.row()).second != CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID &&
-    !WalletAdapter::instance().getTransfer(transferId, transfer))) {
+  if(!_index.isValid() || _index.row() >= m_transfers.size()) {
     return QVariant();
   }
 
@@ -167,7 +239,7 @@ QVariant TransactionsModel::data(const QModelIndex& _index, int _role) const {
     return getToolTipRole(_index);
 
   default:
-    return getUserRole(_index, _role, transactionId, transaction, transferId, transfer);
+    return getUserRole(_index, _role);
   }
 
   return QVariant();
@@ -185,68 +257,126 @@ QModelIndex TransactionsModel::parent(const QModelIndex& _index) const {
   return QModelIndex();
 }
 
-QByteArray TransactionsModel::toCsv() const {
-  QByteArray res;
-  res.append("\"State\",\"Date\",\"Amount\",\"Fee\",\"Hash\",\"Height\",\"Address\",\"Payment ID\"\n");
-  for (quint32 row = 0; row < rowCount(); ++row) {
-    QModelIndex ind = index(row, 0);
-    res.append("\"").append(ind.data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_DATE).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_AMOUNT).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_FEE).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_HASH).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_HEIGHT).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_ADDRESS).data().toString().toUtf8()).append("\",");
-    res.append("\"").append(ind.sibling(row, COLUMN_PAYMENT_ID).data().toString().toUtf8()).append("\"\n");
+quint8 TransactionsModel::getTransactionType(const CryptoNote::WalletLegacyTransaction& _transaction, const QString& _transferAddress,
+  const QString& _walletAddress) {
+  TransactionType transactionType = TransactionType::INPUT;
+  if(_transaction.isCoinbase) {
+    transactionType = TransactionType::MINED;
+  } else if (!_transferAddress.compare(_walletAddress)) {
+    transactionType = TransactionType::INOUT;
+  } else if(_transaction.totalAmount < 0) {
+    transactionType = TransactionType::OUTPUT;
   }
 
-  return res;
+  return static_cast<quint8>(transactionType);
+}
+
+QString TransactionsModel::getTransactionTypeName(quint8 _type) {
+  switch (static_cast<TransactionType>(_type)) {
+  case TransactionType::MINED:
+    return tr("Mined");
+  case TransactionType::INPUT:
+    return tr("Incoming");
+  case TransactionType::OUTPUT:
+    return tr("Outgoing");
+  case TransactionType::INOUT:
+    return tr("Sent to yourself");
+  }
+
+  return QString();
+}
+
+QString TransactionsModel::formatAddress(quint8 _type, const QString& _transferAddress, const QString& _walletAddress,
+  const QString& _label) {
+  TransactionType transactionType = static_cast<TransactionType>(_type);
+  if (transactionType == TransactionType::INPUT || transactionType == TransactionType::MINED ||
+      transactionType == TransactionType::INOUT) {
+    return QString(tr("me (%1)").arg(_walletAddress));
+  }
+
+  if (_transferAddress.isEmpty()) {
+    return tr("(n/a)");
+  }
+
+  if (!_label.isEmpty()) {
+    return QString("%1 (%2)").arg(_label, _transferAddress);
+  }
+
+  return _transferAddress;
+}
+
+TransactionTransferId TransactionsModel::getTransactionTransferId(int _row) const {
+  return m_transfers[_row];
+}
+
+bool TransactionsModel::lessThanByDate(int _leftRow, int _rightRow) const {
+  // Rows without a timestamp (unconfirmed) go after all dated ones and keep their relative order
+  quint64 leftTimestamp = m_rowTimestamp[_leftRow];
+  quint64 rightTimestamp = m_rowTimestamp[_rightRow];
+  if (leftTimestamp == 0 && rightTimestamp == 0) {
+    return _leftRow < _rightRow;
+  }
+
+  if (leftTimestamp == 0) {
+    return false;
+  }
+
+  if (rightTimestamp == 0) {
+    return true;
+  }
+
+  return leftTimestamp < rightTimestamp;
+}
+
+bool TransactionsModel::rowContainsText(int _row, const QString& _text) const {
+  if (_text.isEmpty()) {
+    return true;
+  }
+
+  QString& searchText = m_rowSearchText[_row];
+  if (searchText.isNull()) {
+    QStringList fields;
+    for (int column : {COLUMN_AMOUNT, COLUMN_ADDRESS, COLUMN_PAYMENT_ID, COLUMN_HASH}) {
+      fields.append(getDisplayRole(index(_row, column)).toString());
+    }
+
+    // Separator keeps a match from spanning two fields
+    searchText = fields.join('\n').toLower();
+  }
+
+  return searchText.contains(_text);
 }
 
 QVariant TransactionsModel::getDisplayRole(const QModelIndex& _index) const {
+  int row = _index.row();
   switch(_index.column()) {
   case COLUMN_DATE: {
-    QDateTime date = _index.data(ROLE_DATE).toDateTime();
-    return (date.isNull() || !date.isValid() ? "-" : date.toString("dd.MM.yy HH:mm"));
+    quint64 timestamp = m_rowTimestamp[row];
+    return (timestamp == 0 ? "-" : QDateTime::fromTime_t(timestamp).toString("dd.MM.yy HH:mm"));
   }
 
   case COLUMN_HASH:
-    return _index.data(ROLE_HASH).toByteArray().toHex().toUpper();
+    return getHashString(row);
 
   case COLUMN_ADDRESS: {
-    TransactionType transactionType = static_cast<TransactionType>(_index.data(ROLE_TYPE).value<quint8>());
-    QString transactionAddress = _index.data(ROLE_ADDRESS).toString();
-    if (transactionType == TransactionType::INPUT || transactionType == TransactionType::MINED ||
-        transactionType == TransactionType::INOUT) {
-      return QString(tr("me (%1)").arg(WalletAdapter::instance().getAddress()));
-    } else if (transactionAddress.isEmpty()) {
-      return tr("(n/a)");
-    }
-
-    QModelIndex contactIndex = AddressBookModel::instance().indexFromContact(transactionAddress,1);
-    QString Contact = contactIndex.data(AddressBookModel::ROLE_LABEL).toString();
-    if(!Contact.isEmpty())
-      return QString("%1 (%2)").arg(Contact, transactionAddress);
-
-    return transactionAddress;
+    const QString& transactionAddress = m_rowStrings[m_rowAddressId[row]];
+    return formatAddress(m_rowType[row], transactionAddress, m_walletAddress, AddressBookModel::instance().getLabel(transactionAddress));
   }
 
   case COLUMN_AMOUNT: {
-    qint64 amount = _index.data(ROLE_AMOUNT).value<qint64>();
+    qint64 amount = m_rowAmount[row];
     QString amountStr = CurrencyAdapter::instance().formatAmount(qAbs(amount)).remove(',');
     return (amount < 0 ? "-" + amountStr : amountStr);
   }
 
   case COLUMN_PAYMENT_ID:
-    return _index.data(ROLE_PAYMENT_ID);
+    return m_rowStrings[m_rowPaymentId[row]];
 
-  case COLUMN_FEE: {
-    qint64 fee = _index.data(ROLE_FEE).value<qint64>();
-    return CurrencyAdapter::instance().formatAmount(fee);
-  }
+  case COLUMN_FEE:
+    return CurrencyAdapter::instance().formatAmount(m_rowFee[row]);
 
   case COLUMN_HEIGHT:
-    return QString::number(_index.data(ROLE_HEIGHT).value<quint64>());
+    return QString::number(static_cast<quint64>(m_rowHeight[row]));
 
   default:
     break;
@@ -256,36 +386,25 @@ QVariant TransactionsModel::getDisplayRole(const QModelIndex& _index) const {
 }
 
 QVariant TransactionsModel::getEditRole(const QModelIndex& _index) const {
+  int row = _index.row();
   switch(_index.column()) {
 
-  case COLUMN_STATE: {
-    quint64 numberOfConfirmations = _index.data(ROLE_NUMBER_OF_CONFIRMATIONS).value<quint64>();
-    return numberOfConfirmations;
-  }
+  case COLUMN_STATE:
+    return getNumberOfConfirmations(row);
 
   case COLUMN_DATE: {
-    QDateTime date = _index.data(ROLE_DATE).toDateTime();
-    return (date);
+    quint64 timestamp = m_rowTimestamp[row];
+    return (timestamp > 0 ? QDateTime::fromTime_t(timestamp) : QDateTime());
   }
 
   case COLUMN_HASH:
-    return _index.data(ROLE_HASH).toByteArray().toHex().toUpper();
-
-  case COLUMN_ADDRESS: {
-    TransactionType transactionType = static_cast<TransactionType>(_index.data(ROLE_TYPE).value<quint8>());
-    QString transactionAddress = _index.data(ROLE_ADDRESS).toString();
-    if (transactionType == TransactionType::INPUT || transactionType == TransactionType::MINED ||
-        transactionType == TransactionType::INOUT) {
-      return QString(tr("me (%1)").arg(WalletAdapter::instance().getAddress()));
-    } else if (transactionAddress.isEmpty()) {
-      return tr("(n/a)");
-    }
+    return getHashString(row);
 
-    return transactionAddress;
-  }
+  case COLUMN_ADDRESS:
+    return getAddressString(row);
 
   case COLUMN_AMOUNT: {
-    qint64 amount = _index.data(ROLE_AMOUNT).value<qint64>();
+    qint64 amount = m_rowAmount[row];
     QString amountStr = CurrencyAdapter::instance().formatAmount(qAbs(amount)).remove(',');
     if (amount < 0) {
       amountStr.insert(0, "-");
@@ -294,15 +413,13 @@ QVariant TransactionsModel::getEditRole(const QModelIndex& _index) const {
   }
 
   case COLUMN_PAYMENT_ID:
-    return _index.data(ROLE_PAYMENT_ID);
+    return m_rowStrings[m_rowPaymentId[row]];
 
-  case COLUMN_FEE: {
-    qint64 fee = _index.data(ROLE_FEE).value<qint64>();
-    return CurrencyAdapter::instance().formatAmount(fee);
-  }
+  case COLUMN_FEE:
+    return CurrencyAdapter::instance().formatAmount(m_rowFee[row]);
 
   case COLUMN_HEIGHT:
-    return QString::number(_index.data(ROLE_HEIGHT).value<quint64>());
+    return QString::number(static_cast<quint64>(m_rowHeight[row]));
 
   default:
     break;
@@ -312,8 +429,8 @@ QVariant TransactionsModel::getEditRole(const QModelIndex& _index) const {
 }
 
 QVariant TransactionsModel::getToolTipRole(const QModelIndex& _index) const {
-  quint64 numberOfConfirmations = _index.data(ROLE_NUMBER_OF_CONFIRMATIONS).value<quint64>();
-  TransactionType transactionType = static_cast<TransactionType>(_index.data(ROLE_TYPE).value<quint8>());
+  quint64 numberOfConfirmations = getNumberOfConfirmations(_index.row());
+  TransactionType transactionType = static_cast<TransactionType>(m_rowType[_index.row()]);
 
   if(numberOfConfirmations == 0) {
     if (transactionType == TransactionType::INPUT)
@@ -345,24 +462,9 @@ QVariant TransactionsModel::getToolTipRole(const QModelIndex& _index) const {
 
 QVariant TransactionsModel::getDecorationRole(const QModelIndex& _index) const {
   if(_index.column() == COLUMN_STATE) {
-    quint64 numberOfConfirmations = _index.data(ROLE_NUMBER_OF_CONFIRMATIONS).value<quint64>();
-    if(numberOfConfirmations == 0) {
-      return QPixmap(":icons/unconfirmed");
-    } else if(numberOfConfirmations < 2) {
-      return QPixmap(":icons/clock1");
-    } else if(numberOfConfirmations < 4) {
-      return QPixmap(":icons/clock2");
-    } else if(numberOfConfirmations < 6) {
-      return QPixmap(":icons/clock3");
-    } else if(numberOfConfirmations < 8) {
-      return QPixmap(":icons/clock4");
-    } else if(numberOfConfirmations < 10) {
-      return QPixmap(":icons/clock5");
-    } else {
-      return QPixmap(":icons/transaction");
-    }
+    return getStateIcon(m_rowStateIcon[_index.row()]);
   } else if (_index.column() == COLUMN_ADDRESS) {
-    return _index.data(ROLE_ICON).value<QPixmap>().scaled(20, 20, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    return getAddressIcon(static_cast<TransactionType>(m_rowType[_index.row()]));
   }
 
   return QVariant();
@@ -372,54 +474,41 @@ QVariant TransactionsModel::getAlignmentRole(const QModelIndex& _index) const {
   return headerData(_index.column(), Qt::Horizontal, Qt::TextAlignmentRole);
 }
 
-QVariant TransactionsModel::getUserRole(const QModelIndex& _index, int _role, CryptoNote::TransactionId _transactionId,
-  CryptoNote::WalletLegacyTransaction& _transaction, CryptoNote::TransferId _transferId, CryptoNote::WalletLegacyTransfer& _transfer) const {
+QVariant TransactionsModel::getUserRole(const QModelIndex& _index, int _role) const {
+  int row = _index.row();
   switch(_role) {
   case ROLE_DATE:
-    return (_transaction.timestamp > 0 ? QDateTime::fromTime_t(_transaction.timestamp) : QDateTime());
-
-  case ROLE_TYPE: {
-    QString transactionAddress = _index.data(ROLE_ADDRESS).toString();
-    if(_transaction.isCoinbase) {
-      return static_cast<quint8>(TransactionType::MINED);
-    } else if (!transactionAddress.compare(WalletAdapter::instance().getAddress())) {
-      return static_cast<quint8>(TransactionType::INOUT);
-    } else if(_transaction.totalAmount < 0) {
-      return static_cast<quint8>(TransactionType::OUTPUT);
-    }
+    return (m_rowTimestamp[row] > 0 ? QDateTime::fromTime_t(m_rowTimestamp[row]) : QDateTime());
 
-    return static_cast<quint8>(TransactionType::INPUT);
-  }
+  case ROLE_TYPE:
+    return m_rowType[row];
 
   case ROLE_HASH:
-    return QByteArray(reinterpret_cast<char*>(&_transaction.hash), sizeof(_transaction.hash));
+    return QByteArray(reinterpret_cast<const char*>(&m_rowHash[row]), sizeof(Crypto::Hash));
 
   case ROLE_ADDRESS:
-    return QString::fromStdString(_transfer.address);
+    return m_rowStrings[m_rowAddressId[row]];
 
   case ROLE_AMOUNT:
-    return static_cast<qint64>(_transferId == CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID ? _transaction.totalAmount : -_transfer.amount);
+    return m_rowAmount[row];
 
   case ROLE_PAYMENT_ID:
-    return NodeAdapter::instance().extractPaymentId(_transaction.extra);
+    return m_rowStrings[m_rowPaymentId[row]];
 
-  case ROLE_ICON: {
-    TransactionType transactionType = static_cast<TransactionType>(_index.data(ROLE_TYPE).value<quint8>());
-    return getTransactionIcon(transactionType);
-  }
+  case ROLE_ICON:
+    return getTransactionIcon(static_cast<TransactionType>(m_rowType[row]));
 
   case ROLE_TRANSACTION_ID:
-    return QVariant::fromValue(_transactionId);
+    return QVariant::fromValue(m_transfers[row].first);
 
   case ROLE_HEIGHT:
-    return static_cast<quint64>(_transaction.blockHeight);
+    return static_cast<quint64>(m_rowHeight[row]);
 
   case ROLE_FEE:
-    return static_cast<quint64>(_transaction.fee);
+    return m_rowFee[row];
 
   case ROLE_NUMBER_OF_CONFIRMATIONS:
-    return (_transaction.blockHeight == CryptoNote::WALLET_LEGACY_UNCONFIRMED_TRANSACTION_HEIGHT ? 0 :
-      NodeAdapter::instance().getLastKnownBlockHeight() - _transaction.blockHeight + 1);
+    return getNumberOfConfirmations(row);
 
   case ROLE_COLUMN:
     return headerData(_index.column(), Qt::Horizontal, ROLE_COLUMN);
@@ -431,52 +520,211 @@ QVariant TransactionsModel::getUserRole(const QModelIndex& _index, int _role, Cr
   return QVariant();
 }
 
-void TransactionsModel::reloadWalletTransactions() {
-  beginResetModel();
+QString TransactionsModel::getHashString(int _row) const {
+  return QByteArray(reinterpret_cast<const char*>(&m_rowHash[_row]), sizeof(Crypto::Hash)).toHex().toUpper();
+}
+
+QString TransactionsModel::getAddressString(int _row) const {
+  return formatAddress(m_rowType[_row], m_rowStrings[m_rowAddressId[_row]], m_walletAddress, QString());
+}
+
+quint64 TransactionsModel::getNumberOfConfirmations(int _row) const {
+  // The wallet may see a block before the node reports it as known; keep such rows pending until it does
+  if (m_rowHeight[_row] == CryptoNote::WALLET_LEGACY_UNCONFIRMED_TRANSACTION_HEIGHT || m_rowHeight[_row] > m_knownBlockHeight) {
+    return 0;
+  }
+
+  return m_knownBlockHeight - m_rowHeight[_row] + 1;
+}
+
+void TransactionsModel::updateStateIcon(int _row) {
+  m_rowStateIcon[_row] = getStateIconIndex(getNumberOfConfirmations(_row));
+  if (m_rowStateIcon[_row] != STATE_ICON_CONFIRMED) {
+    m_pendingStateRows.insert(_row);
+  } else {
+    m_pendingStateRows.remove(_row);
+  }
+}
+
+quint32 TransactionsModel::getStringId(const QString& _string) {
+  QHash<QString, quint32>::const_iterator it = m_rowStringIds.constFind(_string);
+  if (it != m_rowStringIds.constEnd()) {
+    return it.value();
+  }
+
+  quint32 id = m_rowStrings.size();
+  m_rowStrings.append(_string);
+  m_rowStringIds.insert(_string, id);
+  return id;
+}
+
+void TransactionsModel::appendRow(CryptoNote::TransactionId _transactionId, const CryptoNote::WalletLegacyTransaction& _transaction,
+  CryptoNote::TransferId _transferId, const CryptoNote::WalletLegacyTransfer& _transfer, const QString& _paymentId) {
+  int row = m_transfers.size();
+  m_transfers.append(TransactionTransferId(_transactionId, _transferId));
+  m_rowHash.resize(row + 1);
+  m_rowTimestamp.resize(row + 1);
+  m_rowAmount.resize(row + 1);
+  m_rowFee.resize(row + 1);
+  m_rowHeight.resize(row + 1);
+  m_rowType.resize(row + 1);
+  m_rowAddressId.resize(row + 1);
+  m_rowPaymentId.resize(row + 1);
+  m_rowSearchText.resize(row + 1);
+  m_rowStateIcon.resize(row + 1);
+  setRowData(row, _transaction, _transferId, _transfer, _paymentId);
+}
+
+void TransactionsModel::setRowData(int _row, const CryptoNote::WalletLegacyTransaction& _transaction, CryptoNote::TransferId _transferId,
+  const CryptoNote::WalletLegacyTransfer& _transfer, const QString& _paymentId) {
+  if (m_walletAddress.isEmpty()) {
+    m_walletAddress = WalletAdapter::instance().getAddress();
+  }
+
+  QString transferAddress = QString::fromStdString(_transfer.address);
+
+  m_rowHash[_row] = _transaction.hash;
+  m_rowTimestamp[_row] = _transaction.timestamp;
+  m_rowAmount[_row] = (_transferId == CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID ? _transaction.totalAmount : -_transfer.amount);
+  m_rowFee[_row] = _transaction.fee;
+  m_rowHeight[_row] = _transaction.blockHeight;
+  m_rowType[_row] = getTransactionType(_transaction, transferAddress, m_walletAddress);
+  m_rowAddressId[_row] = getStringId(transferAddress);
+  m_rowPaymentId[_row] = getStringId(_paymentId);
+  m_rowSearchText[_row].clear();
+  updateStateIcon(_row);
+}
+
+void TransactionsModel::reserveRows(int _count) {
+  m_transfers.reserve(_count);
+  m_rowHash.reserve(_count);
+  m_rowTimestamp.reserve(_count);
+  m_rowAmount.reserve(_count);
+  m_rowFee.reserve(_count);
+  m_rowHeight.reserve(_count);
+  m_rowType.reserve(_count);
+  m_rowAddressId.reserve(_count);
+  m_rowPaymentId.reserve(_count);
+  m_rowSearchText.reserve(_count);
+  m_rowStateIcon.reserve(_count);
+}
+
+void TransactionsModel::clearRows() {
   m_transfers.clear();
   m_transactionRow.clear();
+  m_rowHash.clear();
+  m_rowTimestamp.clear();
+  m_rowAmount.clear();
+  m_rowFee.clear();
+  m_rowHeight.clear();
+  m_rowType.clear();
+  m_rowAddressId.clear();
+  m_rowPaymentId.clear();
+  m_rowSearchText.clear();
+  m_rowStateIcon.clear();
+  m_pendingStateRows.clear();
+  m_rowStrings.clear();
+  m_rowStringIds.clear();
+  m_walletAddress.clear();
+}
+
+void TransactionsModel::reloadWalletTransactions() {
+  if (m_loader != nullptr) {
+    m_loader->disconnect(this);
+  }
+
+  // Wallet history is copied on a separate thread, the model is filled in one go when it is done
+  m_loader = new TransactionsLoader;
+  m_loadUpdatedTransactions.clear();
+  connect(m_loader, &QThread::finished, this, &TransactionsModel::walletTransactionsLoaded);
+  connect(m_loader, &QThread::finished, m_loader, &QObject::deleteLater);
+  m_loader->start();
+}
+
+void TransactionsModel::walletTransactionsLoaded() {
+  TransactionsLoader* loader = m_loader;
+  m_loader = nullptr;
+  const QVector<CryptoNote::WalletLegacyTransaction>& transactions = loader->transactions();
+  const QVector<CryptoNote::WalletLegacyTransfer>& transfers = loader->transfers();
+  const QVector<QString>& paymentIds = loader->paymentIds();
+
+  int rowCount = 0;
+  for (const CryptoNote::WalletLegacyTransaction& transaction : transactions) {
+    rowCount += qMax<int>(transaction.transferCount, 1);
+  }
+
+  beginResetModel();
+  clearRows();
+  m_knownBlockHeight = NodeAdapter::instance().getLastKnownBlockHeight();
+  reserveRows(rowCount);
+  m_transactionRow.reserve(transactions.size());
+  CryptoNote::WalletLegacyTransfer noTransfer = CryptoNote::WalletLegacyTransfer();
+  for (CryptoNote::TransactionId transactionId = 0; transactionId < static_cast<CryptoNote::TransactionId>(transactions.size()); ++transactionId) {
+    const CryptoNote::WalletLegacyTransaction& transaction = transactions[transactionId];
+    m_transactionRow.append(qMakePair<quint32, quint32>(m_transfers.size(), qMax<quint32>(transaction.transferCount, 1)));
+    if (transaction.transferCount == 0) {
+      appendRow(transactionId, transaction, CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID, noTransfer, paymentIds[transactionId]);
+      continue;
+    }
+
+    for (CryptoNote::TransferId transferId = transaction.firstTransferId;
+      transferId < transaction.firstTransferId + transaction.transferCount; ++transferId) {
+      appendRow(transactionId, transaction, transferId, (transferId < static_cast<CryptoNote::TransferId>(transfers.size()) ?
+        transfers[transferId] : noTransfer), paymentIds[transactionId]);
+    }
+  }
+
   endResetModel();
 
-  quint32 row_count = 0;
-  for (CryptoNote::TransactionId transactionId = 0; transactionId < WalletAdapter::instance().getTransactionCount(); ++transactionId) {
-    appendTransaction(transactionId, row_count);
+  // Catch up with what the wallet reported while the history was being copied
+  quint64 transactionCount = WalletAdapter::instance().getTransactionCount();
+  if (transactionCount > 0) {
+    appendTransaction(transactionCount - 1);
   }
 
-  if (row_count > 0) {
-    beginInsertRows(QModelIndex(), 0, row_count - 1);
-    endInsertRows();
+  for (CryptoNote::TransactionId transactionId : m_loadUpdatedTransactions) {
+    updateWalletTransaction(transactionId);
   }
+
+  m_loadUpdatedTransactions.clear();
 }
 
-void TransactionsModel::appendTransaction(CryptoNote::TransactionId _transactionId, quint32& _insertedRowCount) {
+bool TransactionsModel::appendTransaction(CryptoNote::TransactionId _transactionId, quint32& _insertedRowCount) {
   CryptoNote::WalletLegacyTransaction transaction;
   if (!WalletAdapter::instance().getTransaction(_transactionId, transaction)) {
-    return;
+    return false;
   }
 
+  QString paymentId = extractPaymentId(transaction);
+  m_transactionRow.append(qMakePair<quint32, quint32>(m_transfers.size(), qMax<quint32>(transaction.transferCount, 1)));
   if (transaction.transferCount) {
-    m_transactionRow[_transactionId] = qMakePair(m_transfers.size(), transaction.transferCount);
     for (CryptoNote::TransferId transfer_id = transaction.firstTransferId;
       transfer_id < transaction.firstTransferId + transaction.transferCount; ++transfer_id) {
-      m_transfers.append(TransactionTransferId(_transactionId, transfer_id));
+      CryptoNote::WalletLegacyTransfer transfer = CryptoNote::WalletLegacyTransfer();
+      WalletAdapter::instance().getTransfer(transfer_id, transfer);
+      appendRow(_transactionId, transaction, transfer_id, transfer, paymentId);
       ++_insertedRowCount;
     }
   } else {
-    m_transfers.append(TransactionTransferId(_transactionId, CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID));
-    m_transactionRow[_transactionId] = qMakePair(m_transfers.size() - 1, 1);
+    appendRow(_transactionId, transaction, CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID, CryptoNote::WalletLegacyTransfer(), paymentId);
     ++_insertedRowCount;
   }
+
+  return true;
 }
 
 void TransactionsModel::appendTransaction(CryptoNote::TransactionId _transactionId) {
-  if (m_transactionRow.contains(_transactionId)) {
+  if (m_loader != nullptr || _transactionId < static_cast<CryptoNote::TransactionId>(m_transactionRow.size())) {
     return;
   }
 
+  m_knownBlockHeight = NodeAdapter::instance().getLastKnownBlockHeight();
   quint32 oldRowCount = rowCount();
   quint32 insertedRowCount = 0;
-  for (quint64 transactionId = m_transactionRow.size(); transactionId <= _transactionId; ++transactionId) {
-    appendTransaction(transactionId, insertedRowCount);
+  for (CryptoNote::TransactionId transactionId = m_transactionRow.size(); transactionId <= _transactionId; ++transactionId) {
+    if (!appendTransaction(transactionId, insertedRowCount)) {
+      break;
+    }
   }
 
   if (insertedRowCount > 0) {
@@ -486,21 +734,65 @@ void TransactionsModel::appendTransaction(CryptoNote::TransactionId _transaction
 }
 
 void TransactionsModel::updateWalletTransaction(CryptoNote::TransactionId _id) {
-  quint32 firstRow = m_transactionRow.value(_id).first;
-  quint32 lastRow = firstRow + m_transactionRow.value(_id).second - 1;
-  Q_EMIT dataChanged(index(firstRow, COLUMN_DATE), index(lastRow, COLUMN_DATE));
+  if (m_loader != nullptr) {
+    m_loadUpdatedTransactions.append(_id);
+    return;
+  }
+
+  if (_id >= static_cast<CryptoNote::TransactionId>(m_transactionRow.size())) {
+    return;
+  }
+
+  CryptoNote::WalletLegacyTransaction transaction;
+  if (!WalletAdapter::instance().getTransaction(_id, transaction)) {
+    return;
+  }
+
+  m_knownBlockHeight = NodeAdapter::instance().getLastKnownBlockHeight();
+  QString paymentId = extractPaymentId(transaction);
+  quint32 firstRow = m_transactionRow[_id].first;
+  quint32 lastRow = firstRow + m_transactionRow[_id].second - 1;
+  for (quint32 row = firstRow; row <= lastRow; ++row) {
+    CryptoNote::TransferId transferId = m_transfers[row].second;
+    CryptoNote::WalletLegacyTransfer transfer = CryptoNote::WalletLegacyTransfer();
+    if (transferId != CryptoNote::WALLET_LEGACY_INVALID_TRANSFER_ID) {
+      WalletAdapter::instance().getTransfer(transferId, transfer);
+    }
+
+    setRowData(row, transaction, transferId, transfer, paymentId);
+  }
+
+  Q_EMIT dataChanged(index(firstRow, 0), index(lastRow, columnCount() - 1));
 }
 
 void TransactionsModel::localBlockchainUpdated(quint64 _height) {
-  if(rowCount() > 0) {
-    Q_EMIT dataChanged(index(0, COLUMN_STATE), index(rowCount() - 1, COLUMN_STATE));
+  Q_UNUSED(_height);
+  m_knownBlockHeight = NodeAdapter::instance().getLastKnownBlockHeight();
+  // Confirmed rows keep their icon, only repaint rows moving to another bucket
+  QList<int> pendingRows = m_pendingStateRows.toList();
+  for (int row : pendingRows) {
+    quint8 stateIcon = m_rowStateIcon[row];
+    updateStateIcon(row);
+    if (m_rowStateIcon[row] != stateIcon) {
+      Q_EMIT dataChanged(index(row, COLUMN_STATE), index(row, COLUMN_STATE));
+    }
   }
 }
 
+void TransactionsModel::addressBookChanged() {
+  // Contact labels are part of the address column text
+  m_rowSearchText.fill(QString());
+}
+
 void TransactionsModel::reset() {
+  if (m_loader != nullptr) {
+    m_loader->disconnect(this);
+    m_loader = nullptr;
+  }
+
+  m_loadUpdatedTransactions.clear();
   beginResetModel();
-  m_transfers.clear();
-  m_transactionRow.clear();
+  clearRows();
   endResetModel();
 }
 
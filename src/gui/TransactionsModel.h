@@ -5,6 +5,7 @@
 #pragma once
 
 #include <QAbstractItemModel>
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 #include <IWalletLegacy.h>
@@ -13,6 +14,8 @@ namespace WalletGui {
 
 typedef QPair<CryptoNote::TransactionId, CryptoNote::TransferId> TransactionTransferId;
 
+class TransactionsLoader;
+
 class TransactionsModel : public QAbstractItemModel {
   Q_OBJECT
   Q_ENUMS(Columns)
@@ -40,11 +43,48 @@ public:
   QModelIndex index(int _row, int _column, const QModelIndex& _parent = QModelIndex()) const Q_DECL_OVERRIDE;
   QModelIndex	parent(const QModelIndex& _index) const Q_DECL_OVERRIDE;
 
-  QByteArray toCsv() const;
+  // Type code of a transaction row as reported by ROLE_TYPE
+  static quint8 getTransactionType(const CryptoNote::WalletLegacyTransaction& _transaction, const QString& _transfer_address,
+    const QString& _wallet_address);
+  static QString getTransactionTypeName(quint8 _type);
+  // Address column text: "me (...)" for received and mined rows, "label (address)" for contacts
+  static QString formatAddress(quint8 _type, const QString& _transfer_address, const QString& _wallet_address,
+    const QString& _label);
+
+  TransactionTransferId getTransactionTransferId(int _row) const;
+
+  // Date ordering of two rows straight from the row store, for the sorting proxies
+  bool lessThanByDate(int _leftRow, int _rightRow) const;
+  // Substring search over amount, address (with contact label), payment id and hash. _text must be lower case.
+  bool rowContainsText(int _row, const QString& _text) const;
 
 private:
   QVector<TransactionTransferId> m_transfers;
-  QHash<CryptoNote::TransactionId, QPair<quint32, quint32> > m_transactionRow;
+  // First row and row count of each transaction, indexed by transaction id
+  QVector<QPair<quint32, quint32> > m_transactionRow;
+  TransactionsLoader* m_loader;
+  QVector<CryptoNote::TransactionId> m_loadUpdatedTransactions;
+
+  // Row store, one element per row in each vector. Filled from the wallet once per transaction,
+  // so data() never has to lock and copy wallet structures.
+  QVector<Crypto::Hash> m_rowHash;
+  QVector<quint64> m_rowTimestamp;
+  QVector<qint64> m_rowAmount;
+  QVector<quint64> m_rowFee;
+  QVector<quint32> m_rowHeight;
+  QVector<quint8> m_rowType;
+  QVector<quint32> m_rowAddressId;
+  QVector<quint32> m_rowPaymentId;
+  QVector<quint8> m_rowStateIcon;
+  // Rows whose state icon can still change as blocks arrive
+  QSet<int> m_pendingStateRows;
+  quint64 m_knownBlockHeight;
+  // Addresses and payment ids are repeated a lot, rows keep ids into this table
+  QVector<QString> m_rowStrings;
+  QHash<QString, quint32> m_rowStringIds;
+  QString m_walletAddress;
+  // Lower case search text per row, built on first search and dropped when the row or the address book changes
+  mutable QVector<QString> m_rowSearchText;
 
   TransactionsModel();
   ~TransactionsModel();
@@ -54,14 +94,27 @@ private:
   QVariant getDecorationRole(const QModelIndex& _index) const;
   QVariant getAlignmentRole(const QModelIndex& _index) const;
   QVariant getToolTipRole(const QModelIndex& _index) const;
-  QVariant getUserRole(const QModelIndex& _index, int _role, CryptoNote::TransactionId _transactionId, CryptoNote::WalletLegacyTransaction& _transaction,
-    CryptoNote::TransferId _transferId, CryptoNote::WalletLegacyTransfer& _transfer) const;
+  QVariant getUserRole(const QModelIndex& _index, int _role) const;
+
+  QString getHashString(int _row) const;
+  QString getAddressString(int _row) const;
+  quint64 getNumberOfConfirmations(int _row) const;
+  void updateStateIcon(int _row);
+  quint32 getStringId(const QString& _string);
+  void appendRow(CryptoNote::TransactionId _transaction_id, const CryptoNote::WalletLegacyTransaction& _transaction,
+    CryptoNote::TransferId _transfer_id, const CryptoNote::WalletLegacyTransfer& _transfer, const QString& _payment_id);
+  void setRowData(int _row, const CryptoNote::WalletLegacyTransaction& _transaction, CryptoNote::TransferId _transfer_id,
+    const CryptoNote::WalletLegacyTransfer& _transfer, const QString& _payment_id);
+  void reserveRows(int _count);
+  void clearRows();
 
   void reloadWalletTransactions();
-  void appendTransaction(CryptoNote::TransactionId _id, quint32& _row_count);
+  void walletTransactionsLoaded();
+  bool appendTransaction(CryptoNote::TransactionId _id, quint32& _row_count);
   void appendTransaction(CryptoNote::TransactionId _id);
   void updateWalletTransaction(CryptoNote::TransactionId _id);
   void localBlockchainUpdated(quint64 _height);
+  void addressBookChanged();
   void reset();
 };
 
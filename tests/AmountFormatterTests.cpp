@@ -0,0 +1,232 @@
+// Copyright (c) 2016-2017 The Chavezcoin developers
+// Distributed under the MIT/X11 software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <limits>
+
+#include <QtTest>
+
+#include "AmountFormatter.h"
+
+using WalletGui::AmountFormatter;
+
+namespace {
+
+// CurrencyAdapter::formatAmount and parseAmount as they were before AmountFormatter, kept as the reference
+QString referenceFormat(quint64 _amount, int _decimalPlaces) {
+  QString result = QString::number(_amount);
+  if (result.length() < _decimalPlaces + 1) {
+    result = result.rightJustified(_decimalPlaces + 1, '0');
+  }
+
+  quint32 dot_pos = result.length() - _decimalPlaces;
+  for (quint32 pos = result.length() - 1; pos > dot_pos + 1; --pos) {
+    if (result[pos] == '0') {
+      result.remove(pos, 1);
+    } else {
+      break;
+    }
+  }
+
+  result.insert(dot_pos, ".");
+  for (qint32 pos = dot_pos - 3; pos > 0; pos -= 3) {
+    if (result[pos - 1].isDigit()) {
+        result.insert(pos, ',');
+    }
+  }
+
+  return result;
+}
+
+quint64 referenceParse(const QString& _amountString, int _decimalPlaces) {
+  QString amountString = _amountString.trimmed();
+  amountString.remove(',');
+
+  int pointIndex = amountString.indexOf('.');
+  int fractionSize;
+  if (pointIndex != -1) {
+    fractionSize = amountString.length() - pointIndex - 1;
+    while (_decimalPlaces < fractionSize && amountString.right(1) == "0") {
+      amountString.remove(amountString.length() - 1, 1);
+      --fractionSize;
+    }
+
+    if (_decimalPlaces < fractionSize) {
+      return 0;
+    }
+
+    amountString.remove(pointIndex, 1);
+  } else {
+    fractionSize = 0;
+  }
+
+  if (amountString.isEmpty()) {
+    return 0;
+  }
+
+  for (qint32 i = 0; i < _decimalPlaces - fractionSize; ++i) {
+    amountString.append('0');
+  }
+
+  return amountString.toULongLong();
+}
+
+// Deterministic xorshift, so a failure reproduces
+quint64 nextRandom(quint64& _state) {
+  _state ^= _state << 13;
+  _state ^= _state >> 7;
+  _state ^= _state << 17;
+  return _state;
+}
+
+}
+
+class AmountFormatterTests : public QObject {
+  Q_OBJECT
+
+private Q_SLOTS:
+  void format_data();
+  void format();
+  void parse_data();
+  void parse();
+  void roundTrip_data();
+  void roundTrip();
+  void matchesReference_data();
+  void matchesReference();
+};
+
+void AmountFormatterTests::format_data() {
+  QTest::addColumn<quint64>("amount");
+  QTest::addColumn<quintptr>("decimalPlaces");
+  QTest::addColumn<QString>("text");
+
+  QTest::newRow("zero") << Q_UINT64_C(0) << quintptr(12) << "0.00";
+  QTest::newRow("one unit") << Q_UINT64_C(1) << quintptr(12) << "0.000000000001";
+  QTest::newRow("one coin") << Q_UINT64_C(1000000000000) << quintptr(12) << "1.00";
+  QTest::newRow("trailing zeros") << Q_UINT64_C(1500000000000) << quintptr(12) << "1.50";
+  QTest::newRow("groups") << Q_UINT64_C(1234567890000000) << quintptr(12) << "1,234.56789";
+  QTest::newRow("max") << std::numeric_limits<quint64>::max() << quintptr(12) << "18,446,744.073709551615";
+  QTest::newRow("two places") << Q_UINT64_C(123456) << quintptr(2) << "1,234.56";
+  QTest::newRow("more places than digits") << Q_UINT64_C(42) << quintptr(25) << "0.0000000000000000000000042";
+}
+
+void AmountFormatterTests::format() {
+  QFETCH(quint64, amount);
+  QFETCH(quintptr, decimalPlaces);
+  QFETCH(QString, text);
+
+  QCOMPARE(AmountFormatter::format(amount, decimalPlaces), text);
+}
+
+void AmountFormatterTests::parse_data() {
+  QTest::addColumn<QString>("text");
+  QTest::addColumn<quint64>("amount");
+
+  QTest::newRow("integer") << "12" << Q_UINT64_C(12000000000000);
+  QTest::newRow("fraction") << "0.5" << Q_UINT64_C(500000000000);
+  QTest::newRow("no integer part") << ".5" << Q_UINT64_C(500000000000);
+  QTest::newRow("groups") << "1,234.56789" << Q_UINT64_C(1234567890000000);
+  QTest::newRow("spaces and sign") << "  +1.5 " << Q_UINT64_C(1500000000000);
+  QTest::newRow("extra zero places") << "1.0000000000000" << Q_UINT64_C(1000000000000);
+  QTest::newRow("too many places") << "1.0000000000001" << Q_UINT64_C(0);
+  QTest::newRow("two points") << "1.2.3" << Q_UINT64_C(0);
+  QTest::newRow("letters") << "1a" << Q_UINT64_C(0);
+  QTest::newRow("negative") << "-1" << Q_UINT64_C(0);
+  QTest::newRow("empty") << "" << Q_UINT64_C(0);
+  QTest::newRow("point only") << "." << Q_UINT64_C(0);
+  QTest::newRow("overflow") << "18446745" << Q_UINT64_C(0);
+  QTest::newRow("max") << "18,446,744.073709551615" << std::numeric_limits<quint64>::max();
+}
+
+void AmountFormatterTests::parse() {
+  QFETCH(QString, text);
+  QFETCH(quint64, amount);
+
+  QCOMPARE(AmountFormatter::parse(text, 12), amount);
+}
+
+void AmountFormatterTests::roundTrip_data() {
+  QTest::addColumn<quintptr>("decimalPlaces");
+
+  QTest::newRow("2") << quintptr(2);
+  QTest::newRow("8") << quintptr(8);
+  QTest::newRow("12") << quintptr(12);
+  QTest::newRow("19") << quintptr(19);
+  QTest::newRow("25") << quintptr(25);
+}
+
+void AmountFormatterTests::roundTrip() {
+  QFETCH(quintptr, decimalPlaces);
+
+  QVector<quint64> amounts;
+  for (quint64 amount = 0; amount < 2000; ++amount) {
+    amounts.append(amount);
+  }
+
+  for (quint64 power = 1; power <= std::numeric_limits<quint64>::max() / 10; power *= 10) {
+    amounts << power - 1 << power << power + 1 << power * 7 + 3;
+  }
+
+  amounts << std::numeric_limits<quint64>::max() - 1 << std::numeric_limits<quint64>::max();
+
+  // Pseudo-random amounts over the whole range
+  quint64 state = Q_UINT64_C(88172645463325252);
+  for (int i = 0; i < 100000; ++i) {
+    amounts.append(nextRandom(state) >> (i % 64));
+  }
+
+  Q_FOREACH (quint64 amount, amounts) {
+    QString text = AmountFormatter::format(amount, decimalPlaces);
+    if (AmountFormatter::parse(text, decimalPlaces) != amount) {
+      QFAIL(qPrintable(QString("%1 formatted as %2 does not parse back").arg(amount).arg(text)));
+    }
+  }
+}
+
+void AmountFormatterTests::matchesReference_data() {
+  roundTrip_data();
+}
+
+void AmountFormatterTests::matchesReference() {
+  QFETCH(quintptr, decimalPlaces);
+
+  quint64 state = Q_UINT64_C(88172645463325252) + decimalPlaces;
+  for (int i = 0; i < 100000; ++i) {
+    quint64 amount = nextRandom(state) >> (i % 64);
+    QString text = AmountFormatter::format(amount, decimalPlaces);
+    if (text != referenceFormat(amount, decimalPlaces)) {
+      QFAIL(qPrintable(QString("%1 formatted as %2 instead of %3").arg(amount).arg(text).
+        arg(referenceFormat(amount, decimalPlaces))));
+    }
+
+    if (AmountFormatter::parse(text, decimalPlaces) != referenceParse(text, decimalPlaces)) {
+      QFAIL(qPrintable(QString("%1 parsed differently").arg(text)));
+    }
+  }
+
+  // Mostly malformed text: signs, letters, repeated points and separators, overlong fractions
+  const QString alphabet("0123456789.,+-a00");
+  for (int i = 0; i < 100000; ++i) {
+    QString text;
+    for (int length = nextRandom(state) % 30; length > 0; --length) {
+      text.append(alphabet[static_cast<int>(nextRandom(state) % alphabet.size())]);
+    }
+
+    if (nextRandom(state) % 4 == 0) {
+      text = QString("  %1 ").arg(text);
+    }
+
+    quint64 amount = AmountFormatter::parse(text, decimalPlaces);
+    // The one intended difference: the old code stripped the point before reading the sign, so ".+5" was 0.5
+    if (text.trimmed().remove(',').startsWith(".+")) {
+      QCOMPARE(amount, Q_UINT64_C(0));
+    } else if (amount != referenceParse(text, decimalPlaces)) {
+      QFAIL(qPrintable(QString("\"%1\" parsed as %2 instead of %3").arg(text).arg(amount).
+        arg(referenceParse(text, decimalPlaces))));
+    }
+  }
+}
+
+QTEST_APPLESS_MAIN(AmountFormatterTests)
+
+#include "AmountFormatterTests.moc"